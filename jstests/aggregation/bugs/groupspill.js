@@ -0,0 +1,63 @@
+// $group spills only the partitions that overflow and re-aggregates them one at a time
+
+var t = db.groupspill;
+t.drop();
+
+var bigStr = Array(1024*1024 + 1).toString(); // 1MB of ','
+for (var i = 0; i < 101; i++)
+    t.insert({_id: i, bigStr: i + bigStr});
+
+// the _id index gives the $group its input in _id order
+var pipeline = [{$sort: {_id: 1}},
+                {$group: {_id: {$mod: ['$_id', 50]},
+                          count: {$sum: 1},
+                          first: {$first: '$_id'},
+                          last: {$last: '$_id'},
+                          ids: {$push: '$_id'},
+                          bigStrs: {$push: '$bigStr'}}}];
+
+// the pushed strings don't fit in memory
+var res = t.runCommand('aggregate', {pipeline: pipeline});
+assert.commandFailed(res);
+assert.eq(res.code, 16945);
+
+var results = t.aggregateCursor(pipeline, {allowDiskUsage: true}).toArray();
+assert.eq(50, results.length);
+
+var seen = {};
+results.forEach(function(doc) {
+    assert(!seen[doc._id], "duplicate group " + doc._id);
+    seen[doc._id] = true;
+
+    assert.eq(doc._id == 0 ? 3 : 2, doc.count);
+    assert.eq(doc.count, doc.ids.length);
+    assert.eq(doc.count, doc.bigStrs.length);
+    doc.ids.forEach(function(id) {
+        assert.eq(doc._id, id % 50);
+    });
+
+    // spilling doesn't change the order the documents are accumulated in
+    var expected = [];
+    for (var id = doc._id; id < 101; id += 50)
+        expected.push(id);
+    assert.eq(expected, doc.ids);
+    assert.eq(expected[0], doc.first);
+    assert.eq(expected[expected.length - 1], doc.last);
+    for (var j = 0; j < expected.length; j++)
+        assert.eq(expected[j], parseInt(doc.bigStrs[j]));
+});
+
+// explain reports the memory limit and partitioning of $group
+res = t.runCommand('aggregate', {pipeline: pipeline, explain: true});
+assert.commandWorked(res);
+var group = null;
+res.serverPipeline.forEach(function(stage) {
+    if (stage.$group)
+        group = stage.$group;
+});
+assert(group, tojson(res));
+assert.eq(100*1024*1024, group.$stats.maxMemoryUsageBytes);
+assert.gt(group.$stats.partitions, 1);
+
+// don't leave large collection laying around
+t.drop();
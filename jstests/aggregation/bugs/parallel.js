@@ -0,0 +1,88 @@
+// the stages up to the first $group can run on several threads, check we get the same answers
+
+var t = db.aggparallel;
+t.drop();
+
+for (var i = 0; i < 5000; i++) {
+    t.insert({_id: i, a: i % 13, b: i % 7, tags: ['x' + (i % 3), 'y' + (i % 5)], s: 'str' + i});
+}
+
+function setWorkers(n) {
+    var res = db.adminCommand({setParameter: 1, internalAggregationWorkerThreads: n});
+    assert.commandWorked(res);
+    return res.was;
+}
+
+function sortById(docs) {
+    return docs.sort(function(l, r) { return bsonWoCompare({x: l._id}, {x: r._id}); });
+}
+
+// $push/$addToSet order depends on which worker saw what, so compare sets
+function normalize(docs) {
+    docs.forEach(function(doc) {
+        for (var f in doc) {
+            if (doc[f] instanceof Array)
+                doc[f].sort();
+        }
+    });
+    return sortById(docs);
+}
+
+var pipelines = [
+    [{$group: {_id: '$a', count: {$sum: 1}, total: {$sum: '$_id'}, avg: {$avg: '$b'}}}],
+    [{$match: {b: {$lt: 5}}},
+     {$project: {a: 1, c: {$multiply: ['$a', '$b']}}},
+     {$group: {_id: {a: '$a'}, c: {$max: '$c'}, m: {$min: '$c'}, ids: {$addToSet: '$c'}}},
+     {$sort: {'_id.a': -1}}],
+    [{$unwind: '$tags'},
+     {$group: {_id: '$tags', n: {$sum: 1}, bs: {$addToSet: '$b'}}}],
+    [{$group: {_id: '$b'}}, {$group: {_id: null, n: {$sum: 1}}}],
+    [{$match: {_id: {$gt: 100000}}}, {$group: {_id: '$a', n: {$sum: 1}}}],
+];
+
+var oldWorkers = setWorkers(1);
+var expected = pipelines.map(function(p) { return normalize(t.aggregate(p).result); });
+
+setWorkers(4);
+pipelines.forEach(function(p, i) {
+    assert.eq(expected[i], normalize(t.aggregate(p).result), tojson(p));
+    assert.eq(expected[i], normalize(t.aggregateCursor(p).toArray()), tojson(p));
+});
+
+// these depend on the order the $group sees its input in, so they must not be split up
+var orderedPipelines = [
+    [{$match: {_id: {$lt: 300}}},
+     {$group: {_id: null, ids: {$push: '$_id'}}}],
+    [{$sort: {b: 1, _id: -1}},
+     {$group: {_id: '$a', first: {$first: '$_id'}, last: {$last: '$_id'}, n: {$sum: 1}}}],
+    [{$sort: {_id: -1}},
+     {$match: {b: 3}},
+     {$group: {_id: '$a', ids: {$push: '$_id'}}}],
+    [{$sort: {_id: -1}}, {$group: {_id: '$a', n: {$sum: 1}}}],
+];
+
+setWorkers(1);
+var expectedOrdered = orderedPipelines.map(function(p) {
+    return sortById(t.aggregate(p).result);
+});
+
+setWorkers(4);
+orderedPipelines.forEach(function(p, i) {
+    assert.eq(expectedOrdered[i], sortById(t.aggregate(p).result), tojson(p));
+    assert.eq(expectedOrdered[i], sortById(t.aggregateCursor(p).toArray()), tojson(p));
+});
+
+// asking for more workers than the server runs at once still gets the same answers
+setWorkers(1000);
+pipelines.forEach(function(p, i) {
+    assert.eq(expected[i], normalize(t.aggregate(p).result), tojson(p));
+});
+
+// errors in a worker come back to the client
+var res = t.runCommand('aggregate', {pipeline: [{$project: {x: {$divide: ['$a', 0]}}},
+                                                {$group: {_id: '$x'}}]});
+assert.commandFailed(res);
+assert.eq(16608, res.code);
+
+setWorkers(oldWorkers);
+t.drop();
@@ -0,0 +1,36 @@
+// Bulk inserts add keys for non-unique indexes per batch; check the indexes stay consistent with
+// the collection, including when some documents in a batch fail.
+
+var coll = db.bulkInsert2
+coll.drop()
+
+coll.ensureIndex({ a : 1 })
+coll.ensureIndex({ b : 1 })
+coll.ensureIndex({ u : 1 }, { unique : true })
+
+var batch = []
+for( var i = 0; i < 1000; i++ ){
+    batch.push({ _id : i, a : i % 7, b : [ i, -i ], u : i })
+}
+coll.insert( batch )
+assert.isnull( db.getLastError() )
+assert.eq( 1000, coll.count() )
+
+// duplicate _id and duplicate unique key in the middle of a batch, without continueOnError
+batch = [ { _id : 1000, a : 1, u : 1000 }, { _id : 5, a : 1, u : 1001 }, { _id : 1001, a : 1, u : 1002 } ]
+coll.insert( batch )
+assert.neq( null, db.getLastError() )
+assert.eq( 1001, coll.count() )
+
+// and with continueOnError
+batch = [ { _id : 1002, a : 2, u : 1003 }, { _id : 1003, a : 2, u : 3 }, { _id : 1004, a : 2, u : 1004 } ]
+coll.insert( batch, 1 /* ContinueOnError */ )
+assert.eq( 1003, coll.count() )
+
+assert.eq( coll.count(), coll.find().hint({ a : 1 }).itcount() )
+assert.eq( coll.count(), coll.find({ u : { $gte : 0 } }).hint({ u : 1 }).itcount() )
+assert.eq( 1000, coll.find({ b : { $lte : 0 } }).hint({ b : 1 }).itcount() )
+assert.eq( 0, coll.find({ a : 2, u : 3 }).hint({ a : 1 }).itcount() )
+
+var res = coll.validate( true )
+assert( res.valid, tojson( res ) )
@@ -88,3 +88,15 @@ var total = t.find().hint({"_id" : 1}).toArray().length;
 var totala = t.find().hint(goodspec).toArray().length;
 assert.eq(total , totala , "non-sparse index has wrong total");
 assert.lt(totalb , totala , "sparse index should have smaller total");
+
+//test a point lookup only visits the keys with that hash
+var points = db.hashindex1_points;
+points.drop();
+points.ensureIndex( goodspec );
+for(i=0; i < 100; i++ ){
+	points.insert( {a : i % 10} );
+}
+var explain = points.find( {a : 4} ).hint( goodspec ).explain();
+assert.eq( explain.n , 10 , "point lookup returned wrong count");
+assert.eq( explain.nscanned , 10 , "point lookup scanned other keys");
+assert.eq( points.find( {a : 10} ).hint( goodspec ).itcount() , 0 , "missing value was found");
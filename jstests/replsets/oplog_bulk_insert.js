@@ -0,0 +1,55 @@
+// The oplog entries of a multi-document insert are written together.  Check that they come out
+// the same as entries written one at a time: one per document, in order, each with its own
+// timestamp and hash, and that the secondaries apply them.
+
+var replTest = new ReplSetTest( { name : "oplog_bulk_insert" , nodes : 2 , oplogSize : 10 } );
+replTest.startSet();
+replTest.initiate();
+
+var master = replTest.getMaster();
+var mdb = master.getDB( "test" );
+var oplog = master.getDB( "local" ).oplog.rs;
+
+var start = oplog.find().sort( { $natural : -1 } ).limit( 1 ).next().ts;
+
+// enough documents, and big enough ones, to need several oplog allocations
+var padding = new Array( 2000 ).join( "x" );
+var docs = [];
+for ( var i = 0; i < 3000; i++ ) {
+    docs.push( { _id : i , padding : padding } );
+}
+mdb.foo.insert( docs );
+assert.eq( null , mdb.getLastError() );
+
+var entries = oplog.find( { ts : { $gt : start } , ns : "test.foo" } ).toArray();
+assert.eq( docs.length , entries.length );
+var last = start;
+for ( var i = 0; i < entries.length; i++ ) {
+    assert.eq( "i" , entries[ i ].op );
+    assert.eq( i , entries[ i ].o._id );
+    assert( entries[ i ].ts > last , tojson( entries[ i ].ts ) + " after " + tojson( last ) );
+    assert( entries[ i ].h != 0 );
+    last = entries[ i ].ts;
+}
+
+// natural order of the oplog agrees with the timestamps
+var natural = oplog.find( { ts : { $gt : start } , ns : "test.foo" } , { ts : 1 } )
+                   .sort( { $natural : 1 } ).toArray();
+for ( var i = 0; i < natural.length; i++ ) {
+    assert.eq( entries[ i ].ts , natural[ i ].ts );
+}
+
+// a failure part way through a continue-on-error insert still logs every document that made it
+mdb.foo.insert( [ { _id : 3000 } , { _id : 0 } , { _id : 3001 } ] , 1 );
+assert.neq( null , mdb.getLastError() );
+assert.eq( 3002 , mdb.foo.count() );
+assert.eq( 3002 , oplog.find( { ns : "test.foo" , op : "i" } ).itcount() );
+
+replTest.awaitReplication();
+var secondary = replTest.getSecondaries()[ 0 ];
+secondary.setSlaveOk();
+assert.eq( 3002 , secondary.getDB( "test" ).foo.count() );
+assert.eq( mdb.runCommand( { dbhash : 1 } ).md5 ,
+           secondary.getDB( "test" ).runCommand( { dbhash : 1 } ).md5 );
+
+replTest.stopSet();
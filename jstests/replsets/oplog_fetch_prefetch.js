@@ -0,0 +1,48 @@
+// The secondary keeps its next getMore on the sync source in flight while it queues the ops it
+// has.  Check that every op still arrives once and in order, across many batches and when a
+// secondary has a large backlog to catch up on.
+
+var replTest = new ReplSetTest( { name : "oplog_fetch_prefetch" , nodes : 3 , oplogSize : 20 } );
+var nodes = replTest.startSet();
+replTest.initiate();
+
+var master = replTest.getMaster();
+var mdb = master.getDB( "test" );
+
+var padding = new Array( 1000 ).join( "x" );
+var numObjs = 5000;
+for ( var i = 0; i < numObjs; i++ ) {
+    mdb.foo.insert( { _id : i , padding : padding } );
+    if ( i % 100 == 0 )
+        mdb.foo.update( { _id : i } , { $inc : { x : 1 } } );
+}
+replTest.awaitReplication();
+
+var checkSecondaries = function() {
+    replTest.getSecondaries().forEach( function( secondary ) {
+        secondary.setSlaveOk();
+        var sdb = secondary.getDB( "test" );
+        assert.eq( numObjs , sdb.foo.count() , secondary.host );
+        assert.eq( mdb.runCommand( { dbhash : 1 } ).md5 , sdb.runCommand( { dbhash : 1 } ).md5 ,
+                   secondary.host );
+    } );
+};
+checkSecondaries();
+
+// Stop one secondary so it has a large backlog to catch up on once it is back
+var stopped = replTest.getSecondaries()[ 0 ];
+var stoppedId = replTest.getNodeId( stopped );
+replTest.stop( stoppedId );
+
+for ( var i = 0; i < numObjs; i++ ) {
+    mdb.foo.update( { _id : i } , { $inc : { x : 1 } } );
+}
+mdb.getLastError();
+
+replTest.restart( stoppedId );
+replTest.awaitReplication();
+
+assert.eq( numObjs , mdb.foo.find( { x : { $gte : 1 } } ).itcount() );
+checkSecondaries();
+
+replTest.stopSet();
@@ -19,6 +19,8 @@ function testSecondaryMetrics(secondary, opCount, offset) {
     assert(ss.metrics.repl.preload.docs.totalMillis  >= 0, "preload.docs time missing")
     assert(ss.metrics.repl.preload.docs.num >= 0, "preload.indexes num missing")
     assert(ss.metrics.repl.preload.indexes.totalMillis >= 0, "preload.indexes time missing")
+    assert(ss.metrics.repl.preload.docsInMemory >= 0, "preload.docsInMemory missing")
+    assert(ss.metrics.repl.preload.docsNotInMemory >= 0, "preload.docsNotInMemory missing")
 
     assert(ss.metrics.repl.apply.batches.num > 0, "no batches")
     assert(ss.metrics.repl.apply.batches.totalMillis > 0, "no batch time")
@@ -63,6 +65,10 @@ testDB.getLastError(2);
 
 testSecondaryMetrics(secondary, 20000, secondaryBaseOplogInserts -1);
 
+// every updated document was looked up by the prefetcher
+var preload = secondary.getDB("test").serverStatus().metrics.repl.preload;
+assert.eq(preload.docsInMemory + preload.docsNotInMemory, 10000, tojson(preload));
+
 
 // Test getLastError.wtime and that it only records stats for w > 1, see SERVER-9005
 var startMillis = testDB.serverStatus().metrics.getLastError.wtime.totalMillis
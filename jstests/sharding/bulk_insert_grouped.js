@@ -0,0 +1,66 @@
+//
+// Tests continue-on-error bulk inserts whose documents alternate between shards, which mongos
+// regroups per shard before sending
+//
+
+var st = new ShardingTest({ shards : 2, mongos : 1, verbose : 0 });
+st.stopBalancer();
+
+var mongos = st.s;
+var admin = mongos.getDB("admin");
+var shards = mongos.getDB("config").shards.find().toArray();
+var coll = mongos.getCollection(jsTestName() + ".coll");
+
+printjson(admin.runCommand({ enableSharding : coll.getDB() + "" }));
+printjson(admin.runCommand({ movePrimary : coll.getDB() + "", to : shards[0]._id }));
+printjson(coll.ensureIndex({ ukey : 1 }, { unique : true }));
+printjson(admin.runCommand({ shardCollection : coll + "", key : { ukey : 1 } }));
+printjson(admin.runCommand({ split : coll + "", middle : { ukey : 0 } }));
+printjson(admin.runCommand({ moveChunk : coll + "",
+                             find : { ukey : 0 },
+                             to : shards[1]._id,
+                             _waitForDelete : true }));
+
+st.printShardingStatus();
+
+var shardColl = function(i) {
+    return new Mongo(shards[i].host).getCollection(coll + "");
+};
+
+jsTest.log("Bulk insert (yes COE) alternating between shards...");
+
+var inserts = [];
+for (var i = 1; i <= 100; i++) {
+    inserts.push({ ukey : -i });
+    inserts.push({ ukey : i });
+}
+
+coll.insert(inserts, 1);
+assert.eq(null, coll.getDB().getLastError());
+assert.eq(200, coll.find().itcount());
+assert.eq(100, shardColl(0).find().itcount());
+assert.eq(100, shardColl(1).find().itcount());
+
+jsTest.log("Bulk insert (yes COE) alternating between shards with mongod error...");
+
+coll.remove({});
+assert.eq(null, coll.getDB().getLastError());
+
+inserts = [{ ukey : -1 }, { ukey : 1 }, { ukey : -2 }, { ukey : 1 }, { ukey : -3 }, { ukey : 2 }];
+
+coll.insert(inserts, 1);
+var err = coll.getDB().getLastError();
+assert.neq(null, err);
+assert(/dup key/.test(err + ""), err);
+assert.eq(5, coll.find().itcount());
+
+jsTest.log("Bulk insert (no COE) alternating between shards stops at the error...");
+
+coll.remove({});
+assert.eq(null, coll.getDB().getLastError());
+
+coll.insert(inserts);
+assert.neq(null, coll.getDB().getLastError());
+assert.eq(3, coll.find().itcount());
+
+st.stop();
@@ -0,0 +1,68 @@
+// Check that mongos, which asks every shard for its next batch while the current one is being
+// consumed, still returns each document exactly once, and that explain reports the round trip
+// to each shard.
+
+var s = new ShardingTest( "cursor_prefetch" , 2 , 0 , 1 );
+s.stopBalancer();
+
+s.adminCommand( { enablesharding : "test" } );
+s.adminCommand( { shardcollection : "test.foo" , key : { _id : 1 } } );
+
+var db = s.getDB( "test" );
+var t = db.foo;
+
+var numObjs = 3000;
+var padding = new Array( 200 ).join( "x" );
+for ( var i = 0; i < numObjs; i++ ) {
+    t.insert( { _id : i , padding : padding } );
+}
+db.getLastError();
+
+s.adminCommand( { split : "test.foo" , middle : { _id : numObjs / 2 } } );
+s.adminCommand( { movechunk : "test.foo" , find : { _id : numObjs / 2 } ,
+                  to : s.getOther( s.getServer( "test" ) ).name } );
+assert.eq( 2 , s.config.chunks.count() );
+
+// Small batches mean many getMores on each shard
+var seen = {};
+var count = 0;
+t.find().batchSize( 50 ).forEach( function( doc ) {
+    assert( !seen[ doc._id ] , "duplicate " + doc._id );
+    seen[ doc._id ] = true;
+    count++;
+} );
+assert.eq( numObjs , count );
+
+// Sorted merge
+var last = -1;
+t.find().sort( { _id : 1 } ).forEach( function( doc ) {
+    assert.eq( last + 1 , doc._id );
+    last = doc._id;
+} );
+assert.eq( numObjs - 1 , last );
+
+// Abandoning a cursor with a getMore outstanding must not break the connections, nor throw away
+// pooled ones.  The shards only prefetch once the client asks for a second batch.
+var admin = s.getDB( "admin" );
+var createdBefore = admin.runCommand( "connPoolStats" ).totalCreated;
+for ( var i = 0; i < 10; i++ ) {
+    var cursor = t.find().batchSize( 50 );
+    for ( var j = 0; j < 60; j++ )
+        cursor.next();
+    cursor.close();
+}
+for ( var i = 0; i < 10; i++ ) {
+    var cursor = t.find();
+    cursor.next();
+}
+assert.eq( numObjs , t.find().itcount() );
+assert.eq( numObjs , t.count() );
+var createdAfter = admin.runCommand( "connPoolStats" ).totalCreated;
+assert.lt( createdAfter - createdBefore , 10 ,
+           "abandoned cursors dropped pooled connections: " + createdBefore + " -> " + createdAfter );
+
+var explain = t.find().explain();
+assert.eq( 2 , explain.numShards );
+assert.eq( 2 , Object.keySet( explain.shardRoundTripMillis ).length , tojson( explain ) );
+
+s.stop();
@@ -0,0 +1,43 @@
+//
+// Tests that a migration whose chunk takes several _migrateClone batches copies every document
+// intact.  The recipient requests the next batch while it is still inserting the current one.
+//
+
+var st = new ShardingTest({ shards : 2, mongos : 1, other : { chunksize : 200 } });
+st.stopBalancer();
+
+var mongos = st.s0;
+var admin = mongos.getDB( "admin" );
+var coll = mongos.getCollection( "foo.bar" );
+var shards = mongos.getDB( "config" ).shards.find().toArray();
+
+assert( admin.runCommand({ enableSharding : coll.getDB() + "" }).ok );
+printjson( admin.runCommand({ movePrimary : coll.getDB() + "", to : shards[0]._id }) );
+assert( admin.runCommand({ shardCollection : coll + "", key : { _id : 1 } }).ok );
+
+// About 40MB in one chunk, more than twice the 16MB limit on a clone batch
+var padding = new Array( 512 * 1024 ).join( "x" );
+var numDocs = 80;
+for ( var i = 0; i < numDocs; i++ ) {
+    coll.insert({ _id : i, padding : padding, check : i * 7 });
+}
+assert.eq( null, coll.getDB().getLastError() );
+
+jsTest.log( "Moving a chunk larger than one clone batch..." );
+
+var result = admin.runCommand({ moveChunk : coll + "", find : { _id : 0 }, to : shards[1]._id,
+                                _waitForDelete : true });
+printjson( result );
+assert( result.ok );
+
+var donor = st.shard0.getCollection( coll + "" );
+var recipient = st.shard1.getCollection( coll + "" );
+assert.eq( 0, donor.count() );
+assert.eq( numDocs, recipient.count() );
+
+recipient.find().forEach( function( doc ) {
+    assert.eq( doc._id * 7, doc.check, tojson( doc._id ) );
+    assert.eq( padding.length, doc.padding.length, tojson( doc._id ) );
+} );
+
+st.stop();
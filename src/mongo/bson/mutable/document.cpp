@@ -964,18 +964,35 @@ namespace mutablebson {
             }
         }
 
-        // Not all types are currently permitted to be updated in-place.
-        bool canUpdateInPlace(const ElementRep& rep) {
-            const BSONType type = getType(rep);
-            switch(type) {
-            case mongo::NumberDouble:
-            case mongo::Bool:
-            case mongo::NumberInt:
-            case mongo::NumberLong:
-                return true;
-            default:
+        // Returns true if the value of 'targetRep' may be overwritten in place by the value of
+        // 'sourceRep', provided the two serialized elements have the same size. Any BSON type
+        // qualifies, so a same length string, an OID or a same size subobject can all be
+        // written as damage events rather than forcing a new document.
+        bool canUpdateInPlace(const ElementRep& sourceRep, const ElementRep& targetRep) {
+
+            // We can only do an in-place update to an element that is serialized and is not in
+            // the leaf heap.
+            //
+            // TODO: In the future, we can replace values in the leaf heap if they are of the
+            // same size as the origin was. For now, we don't support that.
+            if (!hasValue(targetRep) || (targetRep.objIdx == kLeafObjIdx))
                 return false;
+
+            // sourceRep should be newly created, so it must have a value representation.
+            dassert(hasValue(sourceRep));
+
+            // If the target has substructure, there must be no realized ElementReps that refer
+            // to data inside it, since overwriting the bytes would leave them dangling. We don't
+            // need to worry about the source since it was just created.
+            if (!isLeaf(targetRep)) {
+                if (((targetRep.child.left != kOpaqueRepIdx) &&
+                     (targetRep.child.left != kInvalidRepIdx)) ||
+                    ((targetRep.child.right != kOpaqueRepIdx) &&
+                     (targetRep.child.right != kInvalidRepIdx)))
+                    return false;
             }
+
+            return true;
         }
 
     private:
@@ -1859,54 +1876,41 @@ namespace mutablebson {
         ElementRep& valueRep = impl.getElementRep(newValueIdx);
 
         bool inPlace = false;
-        if (impl.canUpdateInPlace(valueRep) && impl.isInPlaceModeEnabled()) {
+        if (impl.isInPlaceModeEnabled() && impl.canUpdateInPlace(valueRep, thisRep)) {
 
-            // In place updates are currently enabled. We can do an in-place update to an
-            // element that is serialized and is not in the leaf heap.
-            const bool inLeafHeap = (thisRep.objIdx == kLeafObjIdx);
-            const bool hasValue = impl.hasValue(thisRep);
+            // In place updates are currently enabled and permitted for this element. Get the
+            // BSONElement representations of the existing and new value, so we can check if
+            // they are size compatible.
+            BSONElement thisElt = impl.getSerializedElement(thisRep);
+            BSONElement valueElt = impl.getSerializedElement(valueRep);
 
-            // TODO: In the future, we can replace values in the leaf heap if they are of the
-            // same size as the origin was. For now, we don't support that.
-            if (hasValue && !inLeafHeap) {
-
-                // See if the new Element can be recorded as an in-place update.
-                dassert(impl.hasValue(valueRep));
-
-                // Get the BSONElement representations of the existing and new value, so we can
-                // check if they are size compatible.
-                BSONElement thisElt = impl.getSerializedElement(thisRep);
-                BSONElement valueElt = impl.getSerializedElement(valueRep);
+            if (thisElt.size() == valueElt.size()) {
 
-                if (thisElt.size() == valueElt.size()) {
+                // The old and new elements are size compatible. Compute the base offsets of
+                // each BSONElement in the object in which it resides. We use these to calculate
+                // the source and target offsets in the damage entries we are going to write.
 
-                    // The old and new elements are size compatible. Compute the base offsets
-                    // of each BSONElement in the object in which it resides. We use these to
-                    // calculate the source and target offsets in the damage entries we are
-                    // going to write.
+                const DamageEvent::OffsetSizeType targetBaseOffset =
+                    getElementOffset(impl.getObject(thisRep.objIdx), thisElt);
 
-                    const DamageEvent::OffsetSizeType targetBaseOffset =
-                        getElementOffset(impl.getObject(thisRep.objIdx), thisElt);
+                const DamageEvent::OffsetSizeType sourceBaseOffset =
+                    getElementOffset(impl.getObject(valueRep.objIdx), valueElt);
 
-                    const DamageEvent::OffsetSizeType sourceBaseOffset =
-                        getElementOffset(impl.getObject(valueRep.objIdx), valueElt);
-
-                    // If this is a type change, record a damage event for the new type.
-                    if (thisElt.type() != valueElt.type()) {
-                        impl.recordDamageEvent(targetBaseOffset, sourceBaseOffset, 1);
-                    }
+                // If this is a type change, record a damage event for the new type.
+                if (thisElt.type() != valueElt.type()) {
+                    impl.recordDamageEvent(targetBaseOffset, sourceBaseOffset, 1);
+                }
 
-                    dassert(thisElt.fieldNameSize() == valueElt.fieldNameSize());
-                    dassert(thisElt.valuesize() == valueElt.valuesize());
+                dassert(thisElt.fieldNameSize() == valueElt.fieldNameSize());
+                dassert(thisElt.valuesize() == valueElt.valuesize());
 
-                    // Record a damage event for the new value data.
-                    impl.recordDamageEvent(
-                        targetBaseOffset + thisElt.fieldNameSize() + 1,
-                        sourceBaseOffset + thisElt.fieldNameSize() + 1,
-                        thisElt.valuesize());
+                // Record a damage event for the new value data.
+                impl.recordDamageEvent(
+                    targetBaseOffset + thisElt.fieldNameSize() + 1,
+                    sourceBaseOffset + thisElt.fieldNameSize() + 1,
+                    thisElt.valuesize());
 
-                    inPlace = true;
-                }
+                inPlace = true;
             }
         }
 
@@ -2763,6 +2763,80 @@ namespace {
         // ASSERT_EQUALS(value1, x.getValueDouble());
     }
 
+    TEST(DocumentInPlace, StringLifecycle) {
+        mongo::BSONObj obj(mongo::fromjson("{ x : 'foo' }"));
+        mmb::Document doc(obj, mmb::Document::kInPlaceEnabled);
+
+        mmb::Element x = doc.root().leftChild();
+
+        mmb::DamageVector damages;
+        const char* source = NULL;
+
+        // Strings of the same length can be written over each other.
+        x.setValueString("bar");
+        ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+        apply(&obj, damages, source);
+        ASSERT_TRUE(x.hasValue());
+        ASSERT_TRUE(x.isType(mongo::String));
+        ASSERT_EQUALS("bar", x.getValueString());
+        ASSERT_EQUALS(mongo::fromjson("{ x : 'bar' }"), obj);
+    }
+
+    TEST(DocumentInPlace, InPlaceModeIsDisabledByDifferentLengthString) {
+        mongo::BSONObj obj(mongo::fromjson("{ x : 'foo' }"));
+        mmb::Document doc(obj, mmb::Document::kInPlaceEnabled);
+        mmb::Element x = doc.root().leftChild();
+        ASSERT_OK(x.setValueString("foobar"));
+        ASSERT_FALSE(doc.isInPlaceModeEnabled());
+    }
+
+    TEST(DocumentInPlace, OIDLifecycle) {
+        const mongo::OID value1 = mongo::OID::gen();
+        const mongo::OID value2 = mongo::OID::gen();
+
+        mongo::BSONObj obj(BSON("x" << value1));
+        mmb::Document doc(obj, mmb::Document::kInPlaceEnabled);
+
+        mmb::Element x = doc.root().leftChild();
+
+        mmb::DamageVector damages;
+        const char* source = NULL;
+
+        x.setValueOID(value2);
+        ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+        apply(&obj, damages, source);
+        ASSERT_TRUE(x.hasValue());
+        ASSERT_TRUE(x.isType(mongo::jstOID));
+        ASSERT_EQUALS(value2, x.getValueOID());
+    }
+
+    TEST(DocumentInPlace, SameSizeObjectLifecycle) {
+        mongo::BSONObj obj(mongo::fromjson("{ x : { a : 1 }, y : 2 }"));
+        mmb::Document doc(obj, mmb::Document::kInPlaceEnabled);
+
+        mmb::Element x = doc.root().leftChild();
+
+        mmb::DamageVector damages;
+        const char* source = NULL;
+
+        x.setValueObject(BSON("b" << 3));
+        ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+        apply(&obj, damages, source);
+        ASSERT_EQUALS(mongo::fromjson("{ x : { b : 3 }, y : 2 }"), obj);
+    }
+
+    TEST(DocumentInPlace, InPlaceModeIsDisabledBySetValueOverNavigatedObject) {
+        mongo::BSONObj obj(mongo::fromjson("{ x : { a : 1 } }"));
+        mmb::Document doc(obj, mmb::Document::kInPlaceEnabled);
+
+        // Realizing a child of 'x' means there is an Element referring into its bytes, so
+        // 'x' may no longer be overwritten in place.
+        mmb::Element x = doc.root().leftChild();
+        ASSERT_TRUE(x.leftChild().ok());
+        ASSERT_OK(x.setValueObject(BSON("b" << 3)));
+        ASSERT_FALSE(doc.isInPlaceModeEnabled());
+    }
+
     TEST(DocumentComparison, SimpleComparison) {
         const mongo::BSONObj obj =
             mongo::fromjson("{ a : 'a', b : ['b', 'b', 'b'], c : { one : 1.0 } }");
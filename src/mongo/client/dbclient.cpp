@@ -1343,6 +1343,12 @@ namespace mongo {
         }
     }
 
+    void DBClientConnection::shutdown() {
+        _failed = true;
+        if ( p )
+            p->shutdown();
+    }
+
     void DBClientConnection::sayPiggyBack( Message &toSend ) {
         port().piggyBack( toSend );
     }
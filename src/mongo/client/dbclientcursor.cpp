@@ -116,27 +116,121 @@ namespace mongo {
         return ok;
     }
 
+    void DBClientCursor::_assembleGetMore( Message& toSend ) {
+        BufBuilder b;
+        b.appendNum(opts);
+        b.appendStr(ns);
+        b.appendNum(nextBatchSize());
+        b.appendNum(cursorId);
+        toSend.setData(dbGetMore, b.buf(), b.len());
+    }
+
+    void DBClientCursor::setPrefetch( bool prefetch, int minBatchBytes ) {
+        _prefetch = prefetch;
+        _prefetchMinBytes = minBatchBytes;
+        if ( _prefetch && ! _moreConn && ! _morePending && ! batch.m->empty() )
+            _prefetchMore();
+    }
+
+    void DBClientCursor::_prefetchMore() {
+        verify( ! _moreConn && ! _morePending );
+
+        // Only a cursor without a limit knows the next batch will be wanted.
+        if ( ! _prefetch || ! cursorId || haveLimit || ( opts & QueryOption_Exhaust ) )
+            return;
+
+        // A small batch suggests the cursor has caught up with the data.  An awaitData getMore
+        // sent now would just sit on the server, and the caller may want to wait for a bigger
+        // batch to build up instead.
+        if ( batch.m->size() < _prefetchMinBytes )
+            return;
+
+        if ( _client ) {
+            // The reply is read off the same connection by the next requestMore().  Only a plain
+            // connection can be shut down if the cursor goes away before that.
+            if ( ! dynamic_cast<DBClientConnection*>( _client ) )
+                return;
+
+            Message toSend;
+            _assembleGetMore( toSend );
+            _client->say( toSend );
+            _morePending = true;
+            return;
+        }
+
+        // A tailable cursor can wait on the server for a long time, don't hold a pooled
+        // connection through that.
+        if ( opts & QueryOption_CursorTailable )
+            return;
+
+        verify( _scopedHost.size() );
+        auto_ptr<ScopedDbConnection> conn( new ScopedDbConnection( _scopedHost ) );
+        if ( ! conn->get()->lazySupported() ) {
+            conn->done();
+            return;
+        }
+
+        Message toSend;
+        _assembleGetMore( toSend );
+        conn->get()->say( toSend );
+        _moreConn = conn.release();
+    }
+
+    void DBClientCursor::_receivePrefetched() {
+        auto_ptr<ScopedDbConnection> conn( _moreConn );
+        _moreConn = 0;
+
+        auto_ptr<Message> response(new Message());
+        if ( ! conn->get()->recv( *response ) || response->empty() ) {
+            // the reply may be half read, so don't return the connection to the pool
+            conn->kill();
+            uasserted( 17054, str::stream() << "error receiving prefetched batch from "
+                                            << _scopedHost );
+        }
+
+        _client = conn->get();
+        this->batch.m = response;
+        dataReceived();
+        _client = 0;
+        conn->done();
+    }
+
     void DBClientCursor::requestMore() {
         verify( cursorId && batch.pos == batch.nReturned );
 
+        if ( _moreConn ) {
+            // the getMore was sent as soon as the last batch arrived
+            _receivePrefetched();
+            _prefetchMore();
+            return;
+        }
+
+        if ( _morePending ) {
+            _morePending = false;
+            auto_ptr<Message> response(new Message());
+            uassert( 17055, str::stream() << "error receiving prefetched batch from "
+                                          << _client->getServerAddress(),
+                     _client->recv( *response ) && ! response->empty() );
+            this->batch.m = response;
+            dataReceived();
+            _prefetchMore();
+            return;
+        }
+
         if (haveLimit) {
             nToReturn -= batch.nReturned;
             verify(nToReturn > 0);
         }
-        BufBuilder b;
-        b.appendNum(opts);
-        b.appendStr(ns);
-        b.appendNum(nextBatchSize());
-        b.appendNum(cursorId);
 
         Message toSend;
-        toSend.setData(dbGetMore, b.buf(), b.len());
+        _assembleGetMore( toSend );
         auto_ptr<Message> response(new Message());
 
         if ( _client ) {
             _client->call( toSend, *response );
             this->batch.m = response;
             dataReceived();
+            _prefetchMore();
         }
         else {
             verify( _scopedHost.size() );
@@ -147,6 +241,7 @@ namespace mongo {
             dataReceived();
             _client = 0;
             conn.done();
+            _prefetchMore();
         }
     }
 
@@ -287,6 +382,7 @@ namespace mongo {
 
     void DBClientCursor::attach( AScopedConnection * conn ) {
         verify( _scopedHost.size() == 0 );
+        verify( ! _morePending );
         verify( conn );
         verify( conn->get() );
 
@@ -314,7 +410,37 @@ namespace mongo {
 
         DESTRUCTOR_GUARD (
 
-        if ( cursorId && _ownCursor && ! inShutdown() ) {
+        if ( _moreConn ) {
+            // Read the prefetched batch off the wire so the connection can go back to the pool,
+            // rather than making whoever uses the pool next open and authenticate a new one.
+            auto_ptr<ScopedDbConnection> conn( _moreConn );
+            _moreConn = 0;
+
+            Message response;
+            if ( ! inShutdown() && conn->get()->recv( response ) && ! response.empty() )
+                conn->done();
+            else
+                conn->kill();
+        }
+
+        bool killedConn = false;
+        if ( _morePending ) {
+            _morePending = false;
+            if ( inShutdown() || ( opts & QueryOption_AwaitData ) ) {
+                // The reply can take as long as the server's await timeout, don't hold up
+                // shutdown or the owner's next step for it.  The owner sees a failed connection
+                // and the server times the cursor out.
+                static_cast<DBClientConnection*>( _client )->shutdown();
+                killedConn = true;
+            }
+            else {
+                // The owner may go on using the connection, so the reply has to be read off it
+                Message response;
+                _client->recv( response );
+            }
+        }
+
+        if ( cursorId && _ownCursor && ! inShutdown() && ! killedConn ) {
             BufBuilder b;
             b.appendNum( (int)0 ); // reserved
             b.appendNum( (int)1 ); // number
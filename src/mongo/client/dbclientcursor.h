@@ -29,6 +29,7 @@
 namespace mongo {
 
     class AScopedConnection;
+    class ScopedDbConnection;
 
     /** for mock purposes only -- do not create variants of DBClientCursor, nor hang code here 
         @see DBClientMockCursor
@@ -132,6 +133,19 @@ namespace mongo {
         /// Change batchSize after construction. Can change after requesting first batch.
         void setBatchSize(int newBatchSize) { batchSize = newBatchSize; }
 
+        /**
+         * Send the getMore for the next batch as soon as each batch arrives, so the server
+         * produces it while this one is consumed.  Once attach()ed, holds a pooled connection
+         * while a getMore is outstanding, and reads the reply off it to hand it back to the pool
+         * if the cursor is destroyed first; tailable cursors are then left alone.  A cursor still
+         * on its own connection sends the getMore on it, so nothing else may use that connection
+         * until the cursor is destroyed; if an awaitData getMore is still outstanding then, the
+         * connection is shut down rather than waited on.  Ignored for cursors with a limit and
+         * exhaust cursors.
+         * @param minBatchBytes only prefetch after a reply of at least this many bytes
+         */
+        void setPrefetch( bool prefetch, int minBatchBytes = 0 );
+
         DBClientCursor( DBClientBase* client, const string &_ns, BSONObj _query, int _nToReturn,
                         int _nToSkip, const BSONObj *_fieldsToReturn, int queryOptions , int bs ) :
             _client(client),
@@ -146,7 +160,11 @@ namespace mongo {
             resultFlags(0),
             cursorId(),
             _ownCursor( true ),
-            wasError( false ) {
+            wasError( false ),
+            _prefetch( false ),
+            _prefetchMinBytes( 0 ),
+            _moreConn( 0 ),
+            _morePending( false ) {
             _finishConsInit();
         }
 
@@ -162,7 +180,11 @@ namespace mongo {
             resultFlags(0),
             cursorId(_cursorId),
             _ownCursor(true),
-            wasError(false) {
+            wasError(false),
+            _prefetch(false),
+            _prefetchMinBytes(0),
+            _moreConn(0),
+            _morePending(false) {
             _finishConsInit();
         }
 
@@ -236,10 +258,17 @@ namespace mongo {
         string _scopedHost;
         string _lazyHost;
         bool wasError;
+        bool _prefetch;
+        int _prefetchMinBytes;
+        ScopedDbConnection* _moreConn; // set while a prefetched getMore is outstanding
+        bool _morePending; // a prefetched getMore is outstanding on _client
 
         void dataReceived() { bool retry; string lazyHost; dataReceived( retry, lazyHost ); }
         void dataReceived( bool& retry, string& lazyHost );
         void requestMore();
+        void _assembleGetMore( Message& toSend );
+        void _prefetchMore();
+        void _receivePrefetched();
         void exhaustReceiveMore(); // for exhaust
 
         // Don't call from a virtual function
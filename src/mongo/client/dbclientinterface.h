@@ -1222,6 +1222,12 @@ namespace mongo {
          */
         bool isFailed() const { return _failed; }
 
+        /**
+           Close the socket, e.g. to abandon a reply that may take a long time to arrive.  The
+           connection is failed afterwards, as if the server had gone away.
+         */
+        void shutdown();
+
         bool isStillConnected() { return p ? p->isStillConnected() : true; }
 
         MessagingPort& port() { verify(p); return *p; }
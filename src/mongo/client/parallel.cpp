@@ -294,6 +294,16 @@ namespace mongo {
         b.append( "numQueries" , (int)numExplains );
         b.append( "numShards" , (int)out.size() );
 
+        {
+            BSONObjBuilder x( b.subobjStart( "shardRoundTripMillis" ) );
+            for( map<Shard,PCMData>::iterator i = _cursorMap.begin(); i != _cursorMap.end(); ++i ){
+                if( ! i->second.pcState ) continue;
+                x.appendNumber( i->first.getAddress().toString(),
+                                i->second.pcState->initMicros / 1000 );
+            }
+            x.done();
+        }
+
         if ( out.size() == 1 ) {
             b.append( "indexBounds" , indexBounds );
             if ( ! oldPlan.isEmpty() ) {
@@ -478,6 +488,7 @@ namespace mongo {
         _numServers = _servers.size();
         _lastFrom = 0;
         _cursors = 0;
+        _prefetching = false;
 
         if( ! _qSpec.isEmpty() ){
 
@@ -938,6 +949,8 @@ namespace mongo {
                     }
                 }
 
+                state->initTimer.reset();
+
                 bool lazyInit = state->conn->get()->lazySupported();
                 if( lazyInit ){
 
@@ -966,6 +979,8 @@ namespace mongo {
                             << shard.toString() << ", current connection state is "
                             << mdata.toBSON().toString(), success );
 
+                    state->initMicros = state->initTimer.micros();
+
                     mdata.retryNext = false;
                     mdata.initialized = true;
                     mdata.finished = true;
@@ -1113,6 +1128,7 @@ namespace mongo {
                         }
                     }
 
+                    state->initMicros = state->initTimer.micros();
                     mdata.completed = false;
                 }
 
@@ -1300,6 +1316,20 @@ namespace mongo {
         else return i->second.pcState->manager;
     }
 
+    void ParallelSortClusteredCursor::prefetchBatches() {
+        // Not for an unsharded collection, whose cursor is handed straight to the client, nor
+        // when the client asked for a particular number of results and may well not need the
+        // next batch.
+        if( _prefetching || _qSpec.isEmpty() || isCommand() || _qSpec.ntoreturn() != 0 ) return;
+        _prefetching = true;
+
+        for( map<Shard,PCMData>::iterator i = _cursorMap.begin(); i != _cursorMap.end(); ++i ){
+            PCStatePtr state = i->second.pcState;
+            if( ! state || ! state->manager || ! state->cursor || ! i->second.completed ) continue;
+            state->cursor->setPrefetch( true );
+        }
+    }
+
     DBClientCursorPtr ParallelSortClusteredCursor::getShardCursor( const Shard& shard ) {
         map<Shard,PCMData>::iterator i = _cursorMap.find( shard );
 
@@ -27,6 +27,7 @@
 #include "mongo/s/shard.h"
 #include "mongo/s/stale_exception.h"  // for StaleConfigException
 #include "mongo/util/concurrency/mvar.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -90,6 +91,12 @@ namespace mongo {
 
         virtual void explain(BSONObjBuilder& b) = 0;
 
+        /**
+         * Have the servers work on their next batch while this one is consumed, once the client
+         * has shown it wants more than the first batch.  Does nothing by default.
+         */
+        virtual void prefetchBatches() {}
+
     protected:
 
         virtual void _init() = 0;
@@ -266,7 +273,7 @@ namespace mongo {
     public:
 
         ParallelConnectionState() :
-            count( 0 ), done( false ) { }
+            count( 0 ), done( false ), initMicros( 0 ) { }
 
         ShardConnectionPtr conn;
         DBClientCursorPtr cursor;
@@ -279,6 +286,11 @@ namespace mongo {
         long long count;
         bool done;
 
+        // Time from sending the query to reading its first batch, reported by explain.  Replies
+        // are read one shard after another, so this is an upper bound for all but the first.
+        Timer initTimer;
+        long long initMicros;
+
         BSONObj toBSON() const;
 
         string toString() const {
@@ -363,6 +375,9 @@ namespace mongo {
 
         virtual void explain(BSONObjBuilder& b);
 
+        /** Turns on DBClientCursor prefetching for each shard of a sharded collection */
+        virtual void prefetchBatches();
+
     protected:
         void _finishCons();
         void _init();
@@ -391,6 +406,7 @@ namespace mongo {
 
         FilteringClientCursor * _cursors;
         int _needToSkip;
+        bool _prefetching;
 
     private:
         /**
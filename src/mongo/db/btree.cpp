@@ -757,9 +757,15 @@ namespace mongo {
         if( guessIncreasing ) {
             m = h;
         }
+        // Number of leading fields key shares with the keys just below l and just above h.
+        // Every key in between shares the lesser of the two, so those fields are not compared
+        // again.  Helps compound keys whose leading fields repeat.
+        int lowSame = 0;
+        int highSame = 0;
         while ( l <= h ) {
             KeyNode M = this->keyNode(m);
-            int x = key.woCompare(M.key, order);
+            int same;
+            int x = key.woCompare(M.key, order, min(lowSame, highSame), &same);
             if ( x == 0 ) {
                 if( assertIfDup ) {
                     if( k(m).isUnused() ) {
@@ -788,10 +794,14 @@ namespace mongo {
                 unusedRL.GETOFS() &= ~1; // so we can test equality without the used bit messing us up
                 x = recordLoc.compare(unusedRL);
             }
-            if ( x < 0 ) // key < M.key
+            if ( x < 0 ) { // key < M.key
                 h = m-1;
-            else if ( x > 0 )
+                highSame = same;
+            }
+            else if ( x > 0 ) {
                 l = m+1;
+                lowSame = same;
+            }
             else {
                 // found it.
                 pos = m;
@@ -801,15 +811,14 @@ namespace mongo {
         }
         // not found
         pos = l;
-        if ( pos != this->n ) {
+        // these cost two more key comparisons for every bucket searched
+        DEV if ( pos != this->n ) {
             Key keyatpos = keyNode(pos).key;
             wassert( key.woCompare(keyatpos, order) <= 0 );
             if ( pos > 0 ) {
                 if( !( keyNode(pos-1).key.woCompare(key, order) <= 0 ) ) {
-                    DEV {
-                        log() << key.toString() << endl;
-                        log() << keyNode(pos-1).key.toString() << endl;
-                    }
+                    log() << key.toString() << endl;
+                    log() << keyNode(pos-1).key.toString() << endl;
                     wassert(false);
                 }
             }
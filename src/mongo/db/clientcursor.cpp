@@ -46,6 +46,7 @@
 namespace mongo {
 
     ClientCursor::CCById ClientCursor::clientCursorsById;
+    ClientCursor::CCByNs ClientCursor::clientCursorsByNs;
     boost::recursive_mutex& ClientCursor::ccmutex( *(new boost::recursive_mutex()) );
     long long ClientCursor::numberTimedOut = 0;
     set<Runner*> ClientCursor::nonCachedRunners;
@@ -92,6 +93,7 @@ namespace mongo {
         recursive_scoped_lock lock(ccmutex);
         _cursorid = allocCursorId_inlock();
         clientCursorsById.insert( make_pair(_cursorid, this) );
+        clientCursorsByNs[_ns].insert(this);
     }
 
     ClientCursor::~ClientCursor() {
@@ -110,6 +112,13 @@ namespace mongo {
 
             clientCursorsById.erase(_cursorid);
 
+            CCByNs::iterator byNs = clientCursorsByNs.find(_ns);
+            if (byNs != clientCursorsByNs.end()) {
+                byNs->second.erase(this);
+                if (byNs->second.empty())
+                    clientCursorsByNs.erase(byNs);
+            }
+
             // defensive:
             _cursorid = INVALID_CURSOR_ID;
             _pos = -2;
@@ -125,10 +134,23 @@ namespace mongo {
             ClientCursor *cc = clientCursorsById.begin()->second;
             log() << "first one: " << cc->_cursorid << ' ' << cc->_ns << endl;
             clientCursorsById.clear();
+            clientCursorsByNs.clear();
             verify(false);
         }
     }
 
+    // static
+    void ClientCursor::cursorsOnNs_inlock(const StringData& ns, vector<ClientCursor*>* out) {
+        const bool isDB = ns[ns.size() - 1] == '.';
+        CCByNs::const_iterator it = clientCursorsByNs.lower_bound(ns.toString());
+        for (; it != clientCursorsByNs.end(); ++it) {
+            const StringData cursorNs(it->first);
+            if (isDB ? !cursorNs.startsWith(ns) : cursorNs != ns)
+                break;
+            out->insert(out->end(), it->second.begin(), it->second.end());
+        }
+    }
+
     void ClientCursor::invalidate(const char *ns) {
         Lock::assertWriteLocked(ns);
         int len = strlen(ns);
@@ -156,15 +178,23 @@ namespace mongo {
         }
 
         recursive_scoped_lock cclock(ccmutex);
-        CCById::const_iterator it = clientCursorsById.begin();
-        while (it != clientCursorsById.end()) {
-            ClientCursor* cc = it->second;
+
+        // Only the cursors on 'ns' are affected.  Gather their ids first, as deleting a cursor
+        // changes the registry and might take other cursors with it.
+        vector<ClientCursor*> cursors;
+        cursorsOnNs_inlock(ns, &cursors);
+        vector<CursorId> ids;
+        for (vector<ClientCursor*>::const_iterator it = cursors.begin(); it != cursors.end();
+             ++it) {
+            ids.push_back((*it)->_cursorid);
+        }
+
+        for (vector<CursorId>::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+            ClientCursor* cc = find_inlock(*it, false);
+            if (!cc) { continue; }
 
             // We're only interested in cursors over one db.
-            if (cc->_db != db) {
-                ++it;
-                continue;
-            }
+            if (cc->_db != db) { continue; }
 
             bool shouldDelete = false;
 
@@ -188,31 +218,12 @@ namespace mongo {
             // Begin cursor-only DEPRECATED
             else if (cc->c()->shouldDestroyOnNSDeletion()) {
                 verify(NULL == cc->_runner.get());
-
-                if (isDB) {
-                    // already checked that db matched above
-                    dassert(str::startsWith(cc->_ns.c_str(), ns));
-                    shouldDelete = true;
-                }
-                else {
-                    if (str::equals(cc->_ns.c_str(), ns)) {
-                        shouldDelete = true;
-                    }
-                }
+                shouldDelete = true;
             }
             // End cursor-only DEPRECATED
 
             if (shouldDelete) {
-                ClientCursor* toDelete = it->second;
-                CursorId id = toDelete->cursorid();
-                delete toDelete;
-                // We're not following the usual paradigm of saving it, ++it, and deleting the saved
-                // 'it' because deleting 'it' might invalidate the next thing in clientCursorsById.
-                // TODO: Why?
-                it = clientCursorsById.upper_bound(id);
-            }
-            else {
-                ++it;
+                delete cc;
             }
         }
     }
@@ -242,21 +253,18 @@ namespace mongo {
             }
         }
 
-        // TODO: This requires optimization.  We walk through *all* CCs and send the delete to every
-        // CC open on the db we're deleting from.  We could:
-        // 1. Map from ns to open runners,
-        // 2. Map from ns -> (a map of DiskLoc -> runners who care about that DL)
-        //
-        // We could also queue invalidations somehow and have them processed later in the runner's
-        // read locks.
-        for (CCById::const_iterator it = clientCursorsById.begin(); it != clientCursorsById.end();
-             ++it) {
-
-            ClientCursor* cc = it->second;
-            // We're only interested in cursors over one db.
-            if (cc->_db != db) { continue; }
-            if (NULL == cc->_runner.get()) { continue; }
-            cc->_runner->invalidate(dl);
+        // Only the CCs open on the collection we're deleting from are told.  This could go
+        // further and map from ns -> (a map of DiskLoc -> runners who care about that DL), or
+        // queue invalidations somehow and have them processed later in the runner's read locks.
+        CCByNs::const_iterator byNs = clientCursorsByNs.find(ns.toString());
+        if (byNs != clientCursorsByNs.end()) {
+            const set<ClientCursor*>& cursors = byNs->second;
+            for (set<ClientCursor*>::const_iterator it = cursors.begin(); it != cursors.end();
+                 ++it) {
+                ClientCursor* cc = *it;
+                if (NULL == cc->_runner.get()) { continue; }
+                cc->_runner->invalidate(dl);
+            }
         }
 
         // Begin cursor-only
@@ -568,9 +576,13 @@ namespace mongo {
     void ClientCursor::find( const string& ns , set<CursorId>& all ) {
         recursive_scoped_lock lock(ccmutex);
 
-        for ( CCById::iterator i=clientCursorsById.begin(); i!=clientCursorsById.end(); ++i ) {
-            if ( i->second->_ns == ns )
-                all.insert( i->first );
+        CCByNs::const_iterator byNs = clientCursorsByNs.find(ns);
+        if (byNs == clientCursorsByNs.end())
+            return;
+        for (set<ClientCursor*>::const_iterator i = byNs->second.begin();
+             i != byNs->second.end();
+             ++i) {
+            all.insert((*i)->_cursorid);
         }
     }
 
@@ -749,10 +761,10 @@ namespace mongo {
         return ClientCursor::recoverFromYield( data );
     }
 
-    bool ClientCursor::yieldSometimes(RecordNeeds need, bool* yielded) {
+    bool ClientCursor::yieldSometimes(RecordNeeds need, bool* yielded, int32_t hits) {
         if (yielded) { *yielded = false; }
 
-        if ( ! _yieldSometimesTracker.intervalHasElapsed() ) {
+        if ( ! _yieldSometimesTracker.intervalHasElapsed( hits ) ) {
             Record* rec = _recordForYield( need );
             if ( rec ) {
                 // yield for page fault
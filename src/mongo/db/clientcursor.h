@@ -215,9 +215,10 @@ namespace mongo {
          * @param needRecord whether or not the next record has to be read from disk for sure
          *                   if this is true, will yield of next record isn't in memory
          * @param yielded true if a yield occurred, and potentially if a yield did not occur
+         * @param hits the number of iterations this call stands for, see ElapsedTracker
          * @return same as yield()
          */
-        bool yieldSometimes( RecordNeeds need, bool *yielded = 0 );
+        bool yieldSometimes( RecordNeeds need, bool *yielded = 0, int32_t hits = 1 );
         struct YieldData { CursorId _id; bool _doingDeletes; };
         bool prepareToYield( YieldData &data );
         static bool recoverFromYield( const YieldData &data );
@@ -265,6 +266,15 @@ namespace mongo {
         typedef map<CursorId, ClientCursor*> CCById;
         static CCById clientCursorsById;
 
+        // The same cursors grouped by namespace, so that a drop or a delete only has to look at
+        // the cursors open on its own collection.
+        typedef map<string, set<ClientCursor*> > CCByNs;
+        static CCByNs clientCursorsByNs;
+
+        /** @return the cursors open on 'ns', or on any collection in database 'ns' if it ends
+            with a dot.  Assumes ccmutex is held. */
+        static void cursorsOnNs_inlock(const StringData& ns, vector<ClientCursor*>* out);
+
         // A list of NON-CACHED runners.  Any runner that yields must be put into this map before
         // yielding in order to be notified of invalidation and namespace deletion.  Before the
         // runner is deleted, it must be removed from this map.
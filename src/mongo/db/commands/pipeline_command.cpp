@@ -243,6 +243,7 @@ namespace mongo {
 
             // This does the mongod-specific stuff like creating a cursor
             PipelineD::prepareCursorSource(pPipeline, nsToDatabase(ns), pCtx);
+            PipelineD::prepareParallelSources(pPipeline, pCtx);
             pPipeline->stitch();
 
             if (isCursorCommand(cmdObj)) {
@@ -54,6 +54,7 @@
 #include "mongo/db/restapi.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/snapshots.h"
+#include "mongo/db/storage/residency_tracker.h"
 #include "mongo/db/ttl.h"
 #include "mongo/platform/process_id.h"
 #include "mongo/s/d_writeback.h"
@@ -676,6 +677,7 @@ namespace mongo {
         else {
             startTTLBackgroundJob();
         }
+        startResidencyTracker();
 
 #ifndef _WIN32
         CmdLine::launchOk();
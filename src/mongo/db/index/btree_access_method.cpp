@@ -80,6 +80,77 @@ namespace mongo {
         return ret;
     }
 
+    namespace {
+
+        struct KeyAndLoc {
+            KeyAndLoc(const BSONObj& k, const DiskLoc& l) : key(k), loc(l) { }
+            BSONObj key;
+            DiskLoc loc;
+        };
+
+        // Same order as the btree itself: by key, then by record location.
+        class KeyAndLocLessThan {
+        public:
+            KeyAndLocLessThan(const Ordering& ordering) : _ordering(ordering) { }
+
+            bool operator()(const KeyAndLoc& l, const KeyAndLoc& r) const {
+                int x = l.key.woCompare(r.key, _ordering, false);
+                if (x) {
+                    return x < 0;
+                }
+                return l.loc < r.loc;
+            }
+
+        private:
+            Ordering _ordering;
+        };
+
+    }  // namespace
+
+    Status BtreeBasedAccessMethod::insertBulk(const vector<BSONObj>& objs,
+                                              const vector<DiskLoc>& locs,
+                                              const InsertDeleteOptions& options,
+                                              int64_t* numInserted) {
+        verify(options.dupsAllowed);
+        verify(objs.size() == locs.size());
+
+        *numInserted = 0;
+
+        vector<KeyAndLoc> keys;
+        keys.reserve(objs.size());
+        bool multikey = false;
+        for (size_t i = 0; i < objs.size(); ++i) {
+            BSONObjSet docKeys;
+            getKeys(objs[i], &docKeys);
+            multikey = multikey || docKeys.size() > 1;
+            for (BSONObjSet::const_iterator j = docKeys.begin(); j != docKeys.end(); ++j) {
+                keys.push_back(KeyAndLoc(*j, locs[i]));
+            }
+        }
+
+        std::sort(keys.begin(), keys.end(), KeyAndLocLessThan(_ordering));
+
+        Status ret = Status::OK();
+        for (vector<KeyAndLoc>::const_iterator i = keys.begin(); i != keys.end(); ++i) {
+            try {
+                _interface->bt_insert(_descriptor->getHead(), i->loc, i->key, _ordering,
+                                      true, _descriptor->getOnDisk(), true);
+                ++*numInserted;
+            } catch (AssertionException& e) {
+                problem() << " caught assertion insertBulk "
+                          << _descriptor->indexNamespace()
+                          << i->loc.obj()["_id"] << endl;
+                ret = Status(ErrorCodes::InternalError, e.what(), e.getCode());
+            }
+        }
+
+        if (multikey) {
+            _descriptor->setMultikey();
+        }
+
+        return ret;
+    }
+
     bool BtreeBasedAccessMethod::removeOneKey(const BSONObj& key, const DiskLoc& loc) {
         bool ret = false;
 
@@ -143,7 +214,21 @@ namespace mongo {
     Status BtreeBasedAccessMethod::touch(const BSONObj& obj) {
         BSONObjSet keys;
         getKeys(obj, &keys);
+        touchKeys(keys);
+        return Status::OK();
+    }
+
+    Status BtreeBasedAccessMethod::touch(const std::vector<BSONObj>& objs) {
+        // the set sorts the keys and drops the duplicates
+        BSONObjSet keys;
+        for (size_t i = 0; i < objs.size(); ++i) {
+            getKeys(objs[i], &keys);
+        }
+        touchKeys(keys);
+        return Status::OK();
+    }
 
+    void BtreeBasedAccessMethod::touchKeys(const BSONObjSet& keys) {
         for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
             int unusedPos;
             bool unusedFound;
@@ -151,8 +236,6 @@ namespace mongo {
             _interface->locate(_descriptor->getOnDisk(), _descriptor->getHead(), *i, _ordering,
                                unusedPos, unusedFound, unusedDiskLoc, 1);
         }
-
-        return Status::OK();
     }
 
     Status BtreeBasedAccessMethod::validate(int64_t* numKeys) {
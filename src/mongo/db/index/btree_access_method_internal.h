@@ -50,6 +50,11 @@ namespace mongo {
                               const InsertDeleteOptions& options,
                               int64_t* numDeleted);
 
+        virtual Status insertBulk(const vector<BSONObj>& objs,
+                                  const vector<DiskLoc>& locs,
+                                  const InsertDeleteOptions& options,
+                                  int64_t* numInserted);
+
         virtual Status validateUpdate(const BSONObj& from,
                                       const BSONObj& to,
                                       const DiskLoc& loc,
@@ -62,6 +67,8 @@ namespace mongo {
 
         virtual Status touch(const BSONObj& obj);
 
+        virtual Status touch(const std::vector<BSONObj>& objs);
+
         virtual Status validate(int64_t* numKeys);
 
     protected:
@@ -81,6 +88,8 @@ namespace mongo {
 
     private:
         bool removeOneKey(const BSONObj& key, const DiskLoc& loc);
+
+        void touchKeys(const BSONObjSet& keys);
     };
 
     /**
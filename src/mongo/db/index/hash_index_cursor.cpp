@@ -44,6 +44,21 @@ namespace mongo {
         FieldRangeSet frs( "" , position, true, true );
         const vector<FieldInterval>& intervals = frs.range( _hashedField.c_str() ).intervals();
 
+        // A single value, which is what a lookup by hashed shard key is, needs neither the $in
+        // query nor the interval machinery below: it is one descent to the one hashed key.
+        if ( intervals.size() == 1 && intervals[0].equality() ) {
+            BSONObj key = BSON( "" << HashAccessMethod::makeSingleKey( intervals[0]._lower._bound,
+                                                                      _seed, _hashVersion ) );
+            _oldCursor.reset(
+                    BtreeCursor::make( nsdetails( _descriptor->parentNS() ),
+                        _descriptor->getOnDisk(),
+                        key,
+                        key,
+                        true,
+                        1 ) );
+            return Status::OK();
+        }
+
         //Construct a new query based on the hashes of the previous point-intervals
         //e.g. {a : {$in : [ hash(1) , hash(3) , hash(6) ]}}
         BSONObjBuilder newQueryBuilder;
@@ -107,6 +107,12 @@ namespace mongo {
          */
         virtual Status touch(const BSONObj& obj) = 0;
 
+        /**
+         * touch() for many objects at once.  Their keys are looked up in key order, so that
+         * consecutive lookups share most of their path down the index.
+         */
+        virtual Status touch(const std::vector<BSONObj>& objs) = 0;
+
         /**
          * Walk the entire index, checking the internal structure for consistency.
          * Set numKeys to the number of keys in the index.
@@ -119,10 +125,19 @@ namespace mongo {
         virtual Status validate(int64_t* numKeys) = 0;
 
         //
-        // Bulk operations support (TODO)
+        // Bulk operations support
         //
 
-        // virtual Status insertBulk(BulkDocs arg) = 0;
+        /**
+         * Insert the keys for every (objs[i] -> locs[i]) pair.  The keys of the whole batch are
+         * sorted by the index ordering first, so consecutive inserts land in neighbouring
+         * buckets.  Requires 'options.dupsAllowed': a failure can't be pinned on one document, so
+         * errors are logged and reported but nothing is rolled back.
+         */
+        virtual Status insertBulk(const vector<BSONObj>& objs,
+                                  const vector<DiskLoc>& locs,
+                                  const InsertDeleteOptions& options,
+                                  int64_t* numInserted) = 0;
 
         // virtual Status removeBulk(BulkDocs arg) = 0;
     };
@@ -26,6 +26,7 @@
 #include "mongo/db/index/catalog_hack.h"
 #include "mongo/db/kill_current_op.h"
 #include "mongo/db/namespace_details.h"
+#include "mongo/db/pdfile.h"
 #include "mongo/db/pdfile_private.h"
 #include "mongo/db/repl/is_master.h"
 #include "mongo/db/repl/rs.h"
@@ -90,18 +91,26 @@ namespace mongo {
     /**
      * Add the provided (obj, loc) pair to all indices.
      */
-    void indexRecord(const char *ns, NamespaceDetails *d, const BSONObj &obj, const DiskLoc &loc) {
+    void indexRecord(const char *ns, NamespaceDetails *d, const BSONObj &obj, const DiskLoc &loc,
+                     const BulkInsert* bulk) {
         int numIndices = d->getTotalIndexCount();
 
         for (int i = 0; i < numIndices; ++i) {
             IndexDetails &id = d->idx(i);
 
+            if (bulk && bulk->defersIndex(i)) {
+                continue;
+            }
+
             try {
                 addKeysToIndex(ns, d, i, obj, loc, !id.unique() || ignoreUniqueIndex(id));
             }
             catch (AssertionException&) {
                 // TODO: the new index layer indexes either all or no keys, so j <= i can be j < i.
                 for (int j = 0; j <= i; j++) {
+                    if (bulk && bulk->defersIndex(j)) {
+                        continue;
+                    }
                     try {
                         _unindexRecord(d, j, obj, loc, false);
                     }
@@ -115,6 +124,30 @@ namespace mongo {
         }
     }
 
+    /**
+     * Add the keys for all of the records at 'locs' to one index, in key order.
+     */
+    void indexRecordsBulk(NamespaceDetails *d, int idxNo, const vector<DiskLoc>& locs) {
+        auto_ptr<IndexDescriptor> desc(CatalogHack::getDescriptor(d, idxNo));
+        auto_ptr<IndexAccessMethod> iam(CatalogHack::getIndex(desc.get()));
+        InsertDeleteOptions options;
+        options.logIfError = false;
+        options.dupsAllowed = true;
+
+        vector<BSONObj> objs;
+        objs.reserve(locs.size());
+        for (size_t i = 0; i < locs.size(); ++i) {
+            objs.push_back(locs[i].obj());
+        }
+
+        int64_t inserted;
+        Status ret = iam->insertBulk(objs, locs, options, &inserted);
+        if (Status::OK() != ret) {
+            problem() << "bulk index insert into " << desc->indexNamespace()
+                      << " incomplete: " << ret.toString() << endl;
+        }
+    }
+
     //
     // Bulk index building
     //
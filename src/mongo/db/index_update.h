@@ -22,6 +22,7 @@
 #include "mongo/platform/cstdint.h"
 
 namespace mongo {
+    class BulkInsert;
     class NamespaceDetails;
     class Record;
 
@@ -38,7 +39,13 @@ namespace mongo {
                       bool mayInterrupt);
 
     // add index keys for a newly inserted record 
-    void indexRecord(const char *ns, NamespaceDetails *d, const BSONObj& obj, const DiskLoc &loc);
+    // if 'bulk' is given, indexes it defers are skipped; see BulkInsert::finish()
+    void indexRecord(const char *ns, NamespaceDetails *d, const BSONObj& obj, const DiskLoc &loc,
+                     const BulkInsert* bulk = NULL);
+
+    // add index keys for many newly inserted records to index 'idxNo', in key order.
+    // the index must allow duplicate keys.
+    void indexRecordsBulk(NamespaceDetails *d, int idxNo, const vector<DiskLoc>& locs);
 
     bool dropIndexes(NamespaceDetails *d, const char *ns, const char *name, string &errmsg,
                      BSONObjBuilder &anObjBuilder, bool maydeleteIdIndex );
@@ -834,7 +834,7 @@ namespace mongo {
         return ok;
     }
 
-    void checkAndInsert(const char *ns, /*modifies*/BSONObj& js) {
+    void checkAndInsert(const char *ns, /*modifies*/BSONObj& js, BulkInsert* bulk) {
         uassert( 10059 , "object to insert too large", js.objsize() <= BSONObjMaxUserSize);
 
         NamespaceString nsString(ns);
@@ -855,23 +855,76 @@ namespace mongo {
                                         // parent operation using the client interface.  The parent
                                         // operation might not support interrupts.
                                         cc().curop()->parent() == NULL,
-                                        false);
-        logOp("i", ns, js);
+                                        false,
+                                        bulk);
+        // bulk inserts are logged once their deferred index keys are in, see finishBulkInsert()
+        if ( !bulk )
+            logOp("i", ns, js);
+    }
+
+    // A multi-document insert is applied in chunks of roughly this many bytes.  Each chunk gets
+    // its space from a single reservation and adds its non-unique index keys in one pass.
+    static const int BulkInsertChunkBytes = 4 * 1024 * 1024;
+
+    static void finishBulkInsert(const char *ns, BulkInsert& bulk) {
+        bulk.finish();
+        const vector<DiskLoc>& locs = bulk.insertedLocs();
+        vector<BSONObj> objs;
+        objs.reserve(locs.size());
+        for (size_t i = 0; i < locs.size(); i++) {
+            objs.push_back(locs[i].obj());
+        }
+        logInserts(ns, objs);
     }
 
     NOINLINE_DECL void insertMulti(bool keepGoing, const char *ns, vector<BSONObj>& objs, CurOp& op) {
-        size_t i;
-        for (i=0; i<objs.size(); i++){
+        size_t i = 0;
+        while (i < objs.size()) {
+            NamespaceDetails *d = nsdetails(ns);
+            if (!BulkInsert::supported(ns, d)) {
+                // one at a time, e.g. the first insert may create the collection
+                try {
+                    checkAndInsert(ns, objs[i]);
+                    getDur().commitIfNeeded();
+                } catch (const UserException&) {
+                    if (!keepGoing || i == objs.size()-1){
+                        globalOpCounters.incInsertInWriteLock(i);
+                        throw;
+                    }
+                    // otherwise ignore and keep going
+                }
+                i++;
+                continue;
+            }
+
+            size_t end = i;
+            int chunkBytes = 0;
+            while (end < objs.size() && (end == i || chunkBytes < BulkInsertChunkBytes)) {
+                chunkBytes += BulkInsert::spaceFor(ns, d, objs[end]);
+                end++;
+            }
+
+            BulkInsert bulk(ns, d);
+            bulk.reserve(chunkBytes);
             try {
-                checkAndInsert(ns, objs[i]);
-                getDur().commitIfNeeded();
-            } catch (const UserException&) {
-                if (!keepGoing || i == objs.size()-1){
-                    globalOpCounters.incInsertInWriteLock(i);
-                    throw;
+                for (; i < end; i++) {
+                    try {
+                        checkAndInsert(ns, objs[i], &bulk);
+                    } catch (const UserException&) {
+                        if (!keepGoing || i == objs.size()-1){
+                            globalOpCounters.incInsertInWriteLock(i);
+                            throw;
+                        }
+                        // otherwise ignore and keep going
+                    }
                 }
-                // otherwise ignore and keep going
+            } catch (...) {
+                // whatever made it in still needs its index keys and oplog entries
+                finishBulkInsert(ns, bulk);
+                throw;
             }
+            finishBulkInsert(ns, bulk);
+            getDur().commitIfNeeded();
         }
 
         globalOpCounters.incInsertInWriteLock(i);
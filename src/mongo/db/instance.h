@@ -27,6 +27,8 @@
 
 namespace mongo {
 
+    class BulkInsert;
+
     extern string dbExecCommand;
 
     /** a high level recording of operations to the database - sometimes used for diagnostics 
@@ -124,6 +126,10 @@ namespace mongo {
 
     void exitCleanly( ExitCode code );
 
-    void checkAndInsert(const char *ns, BSONObj& js);
+    /**
+     * Validate and insert 'js' into 'ns', adding an _id if needed.  The insert is logged unless
+     * it's part of a BulkInsert, whose caller logs it once the bulk insert is finished.
+     */
+    void checkAndInsert(const char *ns, BSONObj& js, BulkInsert* bulk = NULL);
 
 } // namespace mongo
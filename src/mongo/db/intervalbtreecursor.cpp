@@ -144,6 +144,37 @@ namespace mongo {
         return ok();
     }
 
+    int32_t IntervalBtreeCursor::advanceInBucket() {
+        if ( eof() ) {
+            return 0;
+        }
+
+        const BtreeBucket<V1>* bucket = _curr.bucket.btree<V1>();
+        int32_t count = 1;
+        int32_t pos = _curr.pos;
+        while ( pos + 1 < bucket->getN() ) {
+            if ( _end == BtreeKeyLocation( _curr.bucket, pos + 1 ) ) {
+                break;
+            }
+            const BtreeBucket<V1>::_KeyNode& next = bucket->k( pos + 1 );
+            if ( !next.prevChildBucket.isNull() ) {
+                // Keys in the child bucket come first.
+                break;
+            }
+            ++pos;
+            if ( next.isUsed() ) {
+                ++count;
+            }
+        }
+
+        // Leave the last key for advance(), which also handles the end of the bucket and the
+        // end of the interval.
+        _curr.pos = pos;
+        _nscanned += count - 1;
+        advance();
+        return count;
+    }
+
     BSONObj IntervalBtreeCursor::currKey() const {
         if ( _curr.bucket.isNull() ) {
             return BSONObj();
@@ -103,6 +103,14 @@ namespace mongo {
 
         virtual ~IntervalBtreeCursor();
 
+        /**
+         * Advance past the current key and every following key of the current bucket that comes
+         * before the end of the interval and has no child bucket in between, as if advance()
+         * were called once per key.  For a caller that only counts keys.
+         * @return the number of keys advanced past, counting the current key.
+         */
+        int32_t advanceInBucket();
+
     private:
         IntervalBtreeCursor( NamespaceDetails* namespaceDetails,
                              const IndexDetails& indexDetails,
@@ -589,6 +589,57 @@ namespace mongo {
         return sz;
     }
 
+    int KeyV1::woCompare(const KeyV1& right, const Ordering &order, int skipFields, int *sameFields) const {
+        const unsigned char *l = _keyData;
+        const unsigned char *r = right._keyData;
+
+        *sameFields = 0;
+        if( (*l|*r) == IsBSON )
+            return compareHybrid(right, order);
+
+        unsigned mask = 1;
+        int field = 0;
+        for( ; field < skipFields; field++ ) {
+            if( ((*l ^ *r) & cHASMORE) || (*l & cHASMORE) == 0 ) {
+                // not what the caller thought, compare the whole thing
+                return woCompare(right, order, 0, sameFields);
+            }
+            l += sizeOfElement(l);
+            r += sizeOfElement(r);
+            mask <<= 1;
+        }
+
+        while( 1 ) { 
+            char lval = *l; 
+            char rval = *r;
+            {
+                int x = compare(l, r); // updates l and r pointers
+                if( x ) {
+                    *sameFields = field;
+                    if( order.descending(mask) )
+                        x = -x;
+                    return x;
+                }
+            }
+
+            {
+                int x = ((int)(lval & cHASMORE)) - ((int)(rval & cHASMORE));
+                if( x ) {
+                    *sameFields = field;
+                    return x;
+                }
+                field++;
+                if( (lval & cHASMORE) == 0 )
+                    break;
+            }
+
+            mask <<= 1;
+        }
+
+        *sameFields = field;
+        return 0;
+    }
+
     int KeyV1::dataSize() const { 
         const unsigned char *p = _keyData;
         if( !isCompactFormat() ) {
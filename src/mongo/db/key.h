@@ -34,6 +34,11 @@ namespace mongo {
         explicit KeyBson(const char *keyData) : _o(keyData) { }
         explicit KeyBson(const BSONObj& obj) : _o(obj) { }
         int woCompare(const KeyBson& r, const Ordering &o) const;
+        /** see KeyV1; a v:0 key never skips any fields */
+        int woCompare(const KeyBson& r, const Ordering &o, int skipFields, int *sameFields) const {
+            *sameFields = 0;
+            return woCompare(r, o);
+        }
         BSONObj toBson() const { return _o; }
         string toString() const { return _o.toString(); }
         int dataSize() const { return _o.objsize(); }
@@ -72,6 +77,11 @@ namespace mongo {
         explicit KeyV1(const char *keyData) : _keyData((unsigned char *) keyData) { }
 
         int woCompare(const KeyV1& r, const Ordering &o) const;
+        /** 
+         * As woCompare, for a caller that already knows the first skipFields fields of the two
+         * keys are equal.  Sets sameFields to the number of leading fields that are equal.
+         */
+        int woCompare(const KeyV1& r, const Ordering &o, int skipFields, int *sameFields) const;
         bool woEqual(const KeyV1& r) const;
         BSONObj toBson() const;
         string toString() const { return toBson().toString(); }
@@ -24,6 +24,7 @@
 #include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -178,6 +179,224 @@ namespace mongo {
     }
 
 
+    namespace {
+
+        /**
+         * Compiled regexes keyed by pattern and flags.  The same query shape tends to be sent
+         * over and over, so each of its regexes is compiled once rather than once per query.
+         * A compiled pcrecpp::RE can be used by several threads at once.
+         */
+        class RegexCache {
+        public:
+            RegexCache() : _mutex( "RegexCache" ) {}
+
+            boost::shared_ptr<const pcrecpp::RE> get( const string& regex, const string& flags ) {
+                const Key key( regex, flags );
+                {
+                    SimpleMutex::scoped_lock lk( _mutex );
+                    Map::const_iterator i = _map.find( key );
+                    if ( i != _map.end() )
+                        return i->second;
+                }
+
+                boost::shared_ptr<const pcrecpp::RE> re(
+                    new pcrecpp::RE( regex.c_str(), flags2options( flags.c_str() ) ) );
+
+                SimpleMutex::scoped_lock lk( _mutex );
+                // a workload that never repeats a regex shouldn't grow this without bound
+                if ( _map.size() >= MaxEntries )
+                    _map.clear();
+                _map[key] = re;
+                return re;
+            }
+
+        private:
+            static const size_t MaxEntries = 1000;
+
+            typedef pair<string,string> Key;
+            typedef map<Key, boost::shared_ptr<const pcrecpp::RE> > Map;
+
+            SimpleMutex _mutex;
+            Map _map;
+        } regexCache;
+
+        /** @return the index just past the character class starting at regex[i], npos if none */
+        size_t skipCharacterClass( const string& regex, size_t i ) {
+            i++; // '['
+            if ( i < regex.size() && regex[i] == '^' )
+                i++;
+            if ( i < regex.size() && regex[i] == ']' )
+                i++; // a leading ']' is a member of the class
+            while ( i < regex.size() ) {
+                if ( regex[i] == ']' )
+                    return i + 1;
+                if ( regex[i] == '\\' ) {
+                    i += 2;
+                    continue;
+                }
+                if ( regex[i] == '[' && i + 1 < regex.size() && regex[i+1] == ':' ) {
+                    size_t end = regex.find( ":]", i + 2 );
+                    if ( end == string::npos )
+                        return string::npos;
+                    i = end + 2;
+                    continue;
+                }
+                i++;
+            }
+            return string::npos;
+        }
+
+        /** @return the index just past the group starting at regex[i], npos if none */
+        size_t skipGroup( const string& regex, size_t i ) {
+            int depth = 0;
+            while ( i < regex.size() ) {
+                switch ( regex[i] ) {
+                case '\\':
+                    i += 2;
+                    continue;
+                case '[':
+                    i = skipCharacterClass( regex, i );
+                    if ( i == string::npos )
+                        return i;
+                    continue;
+                case '(':
+                    depth++;
+                    break;
+                case ')':
+                    if ( --depth == 0 )
+                        return i + 1;
+                    break;
+                }
+                i++;
+            }
+            return string::npos;
+        }
+
+        /**
+         * @return true if regex[i], a '{', starts a {n}, {n,} or {n,m} quantifier, setting *end
+         * to the index of its '}'.  Any other '{' is a literal character.
+         */
+        bool isBraceQuantifier( const string& regex, size_t i, size_t* end ) {
+            size_t j = i + 1;
+            size_t digits = 0;
+            while ( j < regex.size() && isdigit( static_cast<unsigned char>( regex[j] ) ) ) {
+                j++;
+                digits++;
+            }
+            if ( digits == 0 )
+                return false;
+            if ( j < regex.size() && regex[j] == ',' ) {
+                j++;
+                while ( j < regex.size() && isdigit( static_cast<unsigned char>( regex[j] ) ) )
+                    j++;
+            }
+            if ( j == regex.size() || regex[j] != '}' )
+                return false;
+            *end = j;
+            return true;
+        }
+
+        /**
+         * @return the longest run of characters that any string matching 'regex' must contain,
+         * or "" if none can be found.  This only has to be cheap and never wrong: anything that
+         * isn't plainly a required literal ends the current run, and anything not understood
+         * gives up on the whole pattern, since an alternation may follow it.
+         */
+        string requiredLiteral( const string& regex, const string& flags ) {
+            // case insensitive and extended patterns don't match their literals byte for byte
+            if ( flags.find_first_of( "ix" ) != string::npos )
+                return "";
+            // nor necessarily do patterns that change their options part way through
+            if ( regex.find( "(?" ) != string::npos )
+                return "";
+            // and quoted sections would hide metacharacters from the group skipping below
+            if ( regex.find( "\\Q" ) != string::npos )
+                return "";
+
+            string best;
+            string run;
+            size_t i = 0;
+            while ( i < regex.size() ) {
+                const char c = regex[i];
+
+                if ( c == '|' ) {
+                    // alternation outside any group: nothing is required by every branch
+                    return "";
+                }
+
+                size_t braceEnd = 0;
+                if ( c == '*' || c == '?' || c == '+' ||
+                     ( c == '{' && isBraceQuantifier( regex, i, &braceEnd ) ) ) {
+                    // the previous atom, the last character of the run if there is a run, is
+                    // optional or repeated, so the run ends before or with it
+                    if ( c != '+' && !run.empty() ) {
+                        // the whole utf-8 character, not just its last byte
+                        size_t last = run.size() - 1;
+                        while ( last > 0 && ( run[last] & 0xC0 ) == 0x80 )
+                            last--;
+                        run.resize( last );
+                    }
+                    if ( run.size() > best.size() )
+                        best = run;
+                    run.clear();
+
+                    if ( c == '{' )
+                        i = braceEnd;
+                    i++;
+                    continue;
+                }
+
+                if ( c == '\\' ) {
+                    if ( i + 1 == regex.size() )
+                        return "";
+                    const char n = regex[i+1];
+                    if ( !isalnum( static_cast<unsigned char>( n ) ) ) {
+                        // an escaped metacharacter stands for itself
+                        run += n;
+                        i += 2;
+                        continue;
+                    }
+                    if ( !strchr( "dDsSwWbBAzZG", n ) ) {
+                        // \n, \x41, \p{L}, back references...: not worth following
+                        return "";
+                    }
+                    if ( run.size() > best.size() )
+                        best = run;
+                    run.clear();
+                    i += 2;
+                    continue;
+                }
+
+                if ( c == '[' || c == '(' || c == ')' || c == '.' || c == '^' || c == '$' ) {
+                    if ( run.size() > best.size() )
+                        best = run;
+                    run.clear();
+
+                    if ( c == ')' )
+                        return ""; // unbalanced, leave it to pcre
+
+                    if ( c == '[' || c == '(' ) {
+                        i = ( c == '[' ) ? skipCharacterClass( regex, i ) : skipGroup( regex, i );
+                        if ( i == string::npos )
+                            return "";
+                        continue;
+                    }
+
+                    i++;
+                    continue;
+                }
+
+                run += c;
+                i++;
+            }
+
+            if ( run.size() > best.size() )
+                best = run;
+            return best;
+        }
+
+    }
+
     Status RegexMatchExpression::init( const StringData& path, const BSONElement& e ) {
         if ( e.type() != RegEx )
             return Status( ErrorCodes::BadValue, "regex not a regex" );
@@ -192,7 +411,8 @@ namespace mongo {
 
         _regex = regex.toString();
         _flags = options.toString();
-        _re.reset( new pcrecpp::RE( _regex.c_str(), flags2options( _flags.c_str() ) ) );
+        _re = regexCache.get( _regex, _flags );
+        _literal = requiredLiteral( _regex, _flags );
 
         return initPath( path );
     }
@@ -202,11 +422,10 @@ namespace mongo {
         switch (e.type()) {
         case String:
         case Symbol:
-            // TODO
-            //if (rm._prefix.empty())
-                return _re->PartialMatch(e.valuestr());
-                //else
-                //return !strncmp(e.valuestr(), rm._prefix.c_str(), rm._prefix.size());
+            // strstr is far cheaper than pcre, and most strings in a scan don't match
+            if ( !_literal.empty() && !strstr( e.valuestr(), _literal.c_str() ) )
+                return false;
+            return _re->PartialMatch(e.valuestr());
         case RegEx:
             return _regex == e.regex() && _flags == e.regexFlags();
         default:
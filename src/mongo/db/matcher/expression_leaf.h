@@ -21,6 +21,7 @@
 #include <pcrecpp.h>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonmisc.h"
@@ -162,7 +163,12 @@ namespace mongo {
     private:
         std::string _regex;
         std::string _flags;
-        boost::scoped_ptr<pcrecpp::RE> _re;
+
+        // shared with every other expression using the same regex and flags
+        boost::shared_ptr<const pcrecpp::RE> _re;
+
+        // a substring every match contains, checked before running _re; may be empty
+        std::string _literal;
     };
 
     class ModMatchExpression : public LeafMatchExpression {
@@ -906,6 +906,46 @@ namespace mongo {
         ASSERT( regex.matchesSingleElement( multiByteCharacter.firstElement() ) );
     }
 
+    TEST( RegexMatchExpression, MatchesElementRequiredLiteral ) {
+        // patterns whose literal characters are not all required, or not contiguous
+        struct {
+            const char* regex;
+            const char* str;
+            bool matches;
+        } cases[] = {
+            { "abc", "xabcx", true },
+            { "abc", "abd", false },
+            { "ab?c", "ac", true },
+            { "ab*", "a", true },
+            { "ab+c", "abbc", true },
+            { "ab{2}c", "abbc", true },
+            { "foo|bar", "bar", true },
+            { "x(foo|bar)y", "xbary", true },
+            { "x(foo|bar)y", "xbazy", false },
+            { "a\\.b", "a.b", true },
+            { "a\\.b", "axb", false },
+            { "a[)]b", "a)b", true },
+            { "[ab]c", "bc", true },
+            { "error \\d+ in", "error 42 in", true },
+            { "a\\x62c", "abc", true },
+            { "caf\xc3\xa9?s", "cafs", true },
+            // the scan gives up part way through, before an alternation
+            { "error\\n|warning", "warning", true },
+            { "foo\\x41|bar", "bar", true },
+            { "abc{x|yz}", "yz}", true },
+            // a '{' that doesn't start a quantifier is a literal
+            { "ab{x}c", "ab{x}c", true },
+            { "abc{2}d", "abccd", true },
+        };
+
+        for ( size_t i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ ) {
+            BSONObj obj = BSON( "x" << cases[i].str );
+            RegexMatchExpression regex;
+            ASSERT( regex.init( "", cases[i].regex, "" ).isOK() );
+            ASSERT_EQUALS( cases[i].matches, regex.matchesSingleElement( obj.firstElement() ) );
+        }
+    }
+
     TEST( RegexMatchExpression, MatchesScalar ) {
         RegexMatchExpression regex;
         ASSERT( regex.init( "a", "b", "" ).isOK() );
@@ -24,6 +24,8 @@
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/db/matcher/path.h"
 
 namespace mongo {
 
@@ -92,4 +94,35 @@ namespace mongo {
 
     }
 
+    TEST( BSONMatchableDocument, SharedTopLevelFields ) {
+        BSONObj doc = BSON( "x" << 1 <<
+                            "a" << BSON( "b" << 2 ) <<
+                            "c" << BSON_ARRAY( BSON( "d" << 3 ) << BSON( "d" << 4 ) ) <<
+                            "x" << 5 );
+        BSONMatchableDocument mydoc( doc );
+
+        // asked for out of document order, and again after the fields were read
+        const char* paths[] = { "c.d", "a.b", "x", "missing", "a.b", "x.y", "" };
+        const int expected[] = { 3, 2, 1, -1, 2, -1, -1 };
+        for ( int i = 0; i < 7; i++ ) {
+            ElementPath p;
+            ASSERT( p.init( paths[i] ).isOK() );
+
+            boost::scoped_ptr<ElementIterator> cursor( mydoc.getIterator( p ) );
+            ASSERT( cursor->more() );
+            ElementIterator::Context e = cursor->next();
+            if ( expected[i] < 0 ) {
+                ASSERT( e.element().eoo() );
+                ASSERT( !cursor->more() );
+                continue;
+            }
+            ASSERT_EQUALS( expected[i], e.element().numberInt() );
+
+            // and the same as a fresh search of the document
+            BSONElementIterator fresh( p, doc );
+            ASSERT( fresh.more() );
+            ASSERT_EQUALS( 0, fresh.next().element().woCompare( e.element() ) );
+        }
+    }
+
 }
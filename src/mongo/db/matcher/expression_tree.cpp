@@ -18,6 +18,8 @@
 
 #include "mongo/db/matcher/expression_tree.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjiterator.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonmisc.h"
@@ -61,13 +63,117 @@ namespace mongo {
 
     // -----
 
-    bool AndMatchExpression::matches( const MatchableDocument* doc, MatchDetails* details ) const {
+    namespace {
+        // how many documents go by between reorderings of an $and
+        const unsigned ReorderInterval = 1024;
+
+        // cost divided by the chance of failing, which starts out at 1/2
+        template<typename C>
+        double conjunctRank( const C& c ) {
+            return c.cost * ( c.runs + 2.0 ) / ( c.runs - c.passes + 1.0 );
+        }
+
+        struct ConjunctLess {
+            template<typename C>
+            bool operator()( const C& a, const C& b ) const {
+                return conjunctRank( a ) < conjunctRank( b );
+            }
+        };
+    }
+
+    int AndMatchExpression::estimateCost( const MatchExpression* expr ) {
+        switch ( expr->matchType() ) {
+        case AND:
+        case OR:
+        case NOR:
+        case NOT: {
+            int cost = 1;
+            for ( size_t i = 0; i < expr->numChildren(); i++ )
+                cost += estimateCost( expr->getChild( i ) );
+            return cost;
+        }
+        case ATOMIC:
+        case ALWAYS_FALSE:
+            return 0;
+        case LTE: case LT: case EQ: case GT: case GTE:
+        case EXISTS: case TYPE_OPERATOR: case SIZE: case MOD:
+            return 1;
+        case MATCH_IN:
+        case NIN:
+            return 2;
+        case ALL:
+        case ELEM_MATCH_OBJECT:
+        case ELEM_MATCH_VALUE:
+            return 5;
+        case REGEX:
+            return 10;
+        case GEO:
+        case GEO_NEAR:
+            return 20;
+        case WHERE:
+            // runs javascript
+            return 1000;
+        }
+        return 1;
+    }
+
+    void AndMatchExpression::_resetOrder() const {
+        _order.clear();
         for ( size_t i = 0; i < numChildren(); i++ ) {
-            if ( !getChild(i)->matches( doc, details ) ) {
+            Conjunct c = { i, estimateCost( getChild( i ) ), 0, 0 };
+            _order.push_back( c );
+        }
+        _reorder();
+    }
+
+    void AndMatchExpression::_reorder() const {
+        _sinceReorder = 0;
+        // stable, so children that look alike keep the order they were written in
+        std::stable_sort( _order.begin(), _order.end(), ConjunctLess() );
+
+        // older documents count for less, so the order follows changes in the data
+        for ( size_t i = 0; i < _order.size(); i++ ) {
+            _order[i].runs /= 2;
+            _order[i].passes /= 2;
+        }
+    }
+
+    size_t AndMatchExpression::evaluationOrder( size_t i ) const {
+        if ( numChildren() < 2 )
+            return i;
+        if ( _order.size() != numChildren() )
+            _resetOrder();
+        return _order[i].child;
+    }
+
+    bool AndMatchExpression::matches( const MatchableDocument* doc, MatchDetails* details ) const {
+        // with fewer than two children there is no order to pick, so leave this object alone;
+        // the elemMatchKey comes from the last child to set one, so keep the written order
+        if ( numChildren() < 2 || ( details && details->needRecord() ) ) {
+            for ( size_t i = 0; i < numChildren(); i++ ) {
+                if ( !getChild(i)->matches( doc, details ) ) {
+                    if ( details )
+                        details->resetOutput();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        if ( _order.size() != numChildren() )
+            _resetOrder();
+        else if ( ++_sinceReorder == ReorderInterval )
+            _reorder();
+
+        for ( size_t i = 0; i < _order.size(); i++ ) {
+            Conjunct& c = _order[i];
+            c.runs++;
+            if ( !getChild( c.child )->matches( doc, details ) ) {
                 if ( details )
                     details->resetOutput();
                 return false;
             }
+            c.passes++;
         }
         return true;
     }
@@ -56,15 +56,46 @@ namespace mongo {
         std::vector< MatchExpression* > _expressions;
     };
 
+    /**
+     * matches() tries the children cheapest first and, among those of similar cost, the ones
+     * that have failed most often so far, so a document is turned down after as little work as
+     * possible.  The order is recomputed from the observed pass rates every so often, which
+     * makes matches() modify this object when there are two or more children: such an AND must
+     * only be used by one thread at a time.  With fewer children matches() only reads, so an
+     * empty matcher (e.g. GeoCursorBase::otherEmptyMatcher) can be shared between threads.
+     */
     class AndMatchExpression : public ListOfMatchExpression {
     public:
-        AndMatchExpression() : ListOfMatchExpression( AND ){}
+        AndMatchExpression() : ListOfMatchExpression( AND ), _sinceReorder( 0 ){}
         virtual ~AndMatchExpression(){}
 
         virtual bool matches( const MatchableDocument* doc, MatchDetails* details = 0 ) const;
         virtual bool matchesSingleElement( const BSONElement& e ) const;
 
         virtual void debugString( StringBuilder& debug, int level = 0 ) const;
+
+        /** rough relative cost of evaluating 'expr' against one document */
+        static int estimateCost( const MatchExpression* expr );
+
+        /** @return the index of the child matches() tries i-th */
+        size_t evaluationOrder( size_t i ) const;
+
+    private:
+        struct Conjunct {
+            size_t child;
+            int cost;
+            unsigned runs;
+            unsigned passes;
+        };
+
+        /** puts the children in order of cost, forgetting any pass rates */
+        void _resetOrder() const;
+
+        /** sorts by cost over the observed failure rate, then ages the counts */
+        void _reorder() const;
+
+        mutable std::vector<Conjunct> _order;
+        mutable unsigned _sinceReorder;
     };
 
     class OrMatchExpression : public ListOfMatchExpression {
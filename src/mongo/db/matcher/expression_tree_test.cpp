@@ -194,6 +194,59 @@ namespace mongo {
         ASSERT_EQUALS( "1", details.elemMatchKey() );
     }
 
+    TEST( AndOp, CheapClausesFirst ) {
+        BSONObj baseOperand = BSON( "b" << 2 );
+
+        auto_ptr<RegexMatchExpression> sub1( new RegexMatchExpression() );
+        ASSERT( sub1->init( "a", "^x", "" ).isOK() );
+
+        auto_ptr<ComparisonMatchExpression> sub2( new EqualityMatchExpression() );
+        ASSERT( sub2->init( "b", baseOperand[ "b" ] ).isOK() );
+
+        AndMatchExpression andOp;
+        andOp.add( sub1.release() );
+        andOp.add( sub2.release() );
+
+        ASSERT_EQUALS( 1U, andOp.evaluationOrder( 0 ) );
+        ASSERT_EQUALS( 0U, andOp.evaluationOrder( 1 ) );
+        ASSERT( andOp.matchesBSON( BSON( "a" << "xyz" << "b" << 2 ), NULL ) );
+        ASSERT( !andOp.matchesBSON( BSON( "a" << "xyz" << "b" << 3 ), NULL ) );
+        ASSERT( !andOp.matchesBSON( BSON( "a" << "abc" << "b" << 2 ), NULL ) );
+    }
+
+    TEST( AndOp, ReordersByFailureRate ) {
+        BSONObj baseOperand1 = BSON( "a" << 1 );
+        BSONObj baseOperand2 = BSON( "b" << 2 );
+
+        auto_ptr<ComparisonMatchExpression> sub1( new EqualityMatchExpression() );
+        ASSERT( sub1->init( "a", baseOperand1[ "a" ] ).isOK() );
+
+        auto_ptr<ComparisonMatchExpression> sub2( new EqualityMatchExpression() );
+        ASSERT( sub2->init( "b", baseOperand2[ "b" ] ).isOK() );
+
+        AndMatchExpression andOp;
+        andOp.add( sub1.release() );
+        andOp.add( sub2.release() );
+
+        // same cost, so the written order to begin with
+        ASSERT_EQUALS( 0U, andOp.evaluationOrder( 0 ) );
+
+        // the first clause always passes and the second mostly fails
+        for ( int i = 0; i < 5000; i++ ) {
+            bool expected = i % 10 == 0;
+            ASSERT_EQUALS( expected,
+                           andOp.matchesBSON( BSON( "a" << 1 << "b" << ( expected ? 2 : 3 ) ),
+                                              NULL ) );
+        }
+        ASSERT_EQUALS( 1U, andOp.evaluationOrder( 0 ) );
+
+        // and back once the data changes
+        for ( int i = 0; i < 5000; i++ ) {
+            ASSERT( !andOp.matchesBSON( BSON( "a" << 2 << "b" << 2 ), NULL ) );
+        }
+        ASSERT_EQUALS( 0U, andOp.evaluationOrder( 0 ) );
+    }
+
     /**
     TEST( AndOp, MatchesIndexKeyWithoutUnknown ) {
         BSONObj baseOperand1 = BSON( "$gt" << 1 );
@@ -26,10 +26,37 @@ namespace mongo {
     }
 
     BSONMatchableDocument::BSONMatchableDocument( const BSONObj& obj )
-        : _obj( obj ) {
+        : _obj( obj ), _fieldIterator( _obj ) {
     }
 
     BSONMatchableDocument::~BSONMatchableDocument() {
     }
 
+    ElementIterator* BSONMatchableDocument::getIterator( const ElementPath& path ) const {
+        if ( path.fieldRef().numParts() == 0 )
+            return new BSONElementIterator( path, _obj );
+
+        return new BSONElementIterator( path, _obj,
+                                        _getTopLevelField( path.fieldRef().getPart( 0 ) ) );
+    }
+
+    BSONElement BSONMatchableDocument::_getTopLevelField( const StringData& name ) const {
+        for ( size_t i = 0; i < _fields.size(); i++ ) {
+            if ( _fields[i].fieldNameStringData() == name )
+                return _fields[i];
+        }
+
+        if ( _fields.empty() && _fieldIterator.more() )
+            _fields.reserve( 16 );
+
+        while ( _fieldIterator.more() ) {
+            BSONElement e = _fieldIterator.next();
+            _fields.push_back( e );
+            if ( e.fieldNameStringData() == name )
+                return e;
+        }
+
+        return BSONElement();
+    }
+
 }
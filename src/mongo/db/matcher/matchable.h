@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjiterator.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/path.h"
 
@@ -34,6 +37,12 @@ namespace mongo {
 
     };
 
+    /**
+     * Every leaf of an expression asks for its own path, so a query with several predicates
+     * would search the document once per predicate.  Instead the top level fields are read at
+     * most once, in document order, as far as the furthest one asked for so far; every other
+     * lookup is answered from the fields already read.
+     */
     class BSONMatchableDocument : public MatchableDocument {
     public:
         BSONMatchableDocument( const BSONObj& obj );
@@ -41,11 +50,16 @@ namespace mongo {
 
         virtual BSONObj toBSON() const { return _obj; }
 
-        virtual ElementIterator* getIterator( const ElementPath& path ) const {
-            return new BSONElementIterator( path, _obj );
-        }
+        virtual ElementIterator* getIterator( const ElementPath& path ) const;
 
     private:
+        /** @return the top level field 'name' of _obj, EOO if there is none */
+        BSONElement _getTopLevelField( const StringData& name ) const;
+
         BSONObj _obj;
+
+        // top level fields of _obj read so far, in document order
+        mutable std::vector<BSONElement> _fields;
+        mutable BSONObjIterator _fieldIterator;
     };
 }
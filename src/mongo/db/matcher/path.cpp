@@ -75,11 +75,19 @@ namespace mongo {
     // ------
 
     BSONElementIterator::BSONElementIterator( const ElementPath& path, const BSONObj& context )
-        : _path( path ), _context( context ) {
+        : _path( path ), _context( context ), _haveFirst( false ) {
         _state = BEGIN;
         //log() << "path: " << path.fieldRef().dottedField() << " context: " << context << endl;
     }
 
+    BSONElementIterator::BSONElementIterator( const ElementPath& path,
+                                              const BSONObj& context,
+                                              const BSONElement& first )
+        : _path( path ), _context( context ), _first( first ), _haveFirst( true ) {
+        verify( path.fieldRef().numParts() > 0 );
+        _state = BEGIN;
+    }
+
     BSONElementIterator::~BSONElementIterator() {
     }
 
@@ -151,7 +159,9 @@ namespace mongo {
 
         if ( _state == BEGIN ) {
             size_t idxPath = 0;
-            BSONElement e = getFieldDottedOrArray( _context, _path.fieldRef(), &idxPath );
+            BSONElement e = _haveFirst ?
+                getFieldDottedOrArray( _first, _path.fieldRef(), &idxPath ) :
+                getFieldDottedOrArray( _context, _path.fieldRef(), &idxPath );
 
             if ( e.type() != Array ) {
                 _next.reset( e, BSONElement(), false );
@@ -104,6 +104,15 @@ namespace mongo {
     class BSONElementIterator : public ElementIterator {
     public:
         BSONElementIterator( const ElementPath& path, const BSONObj& context );
+
+        /**
+         * 'first' is the field of 'context' named by the first part of 'path', already looked
+         * up by the caller, or EOO if there is no such field.
+         */
+        BSONElementIterator( const ElementPath& path,
+                             const BSONObj& context,
+                             const BSONElement& first );
+
         virtual ~BSONElementIterator();
 
         bool more();
@@ -113,6 +122,9 @@ namespace mongo {
         const ElementPath& _path;
         BSONObj _context;
 
+        BSONElement _first;
+        bool _haveFirst;
+
         enum State { BEGIN, IN_ARRAY, DONE } _state;
         Context _next;
 
@@ -34,14 +34,17 @@ namespace mongo {
         if ( path.numParts() == 0 )
             return doc.getField( "" );
 
-        BSONElement res;
+        return getFieldDottedOrArray( doc.getField( path.getPart( 0 ) ), path, idxPath );
+    }
+
+    BSONElement getFieldDottedOrArray( const BSONElement& first,
+                                       const FieldRef& path,
+                                       size_t* idxPath ) {
+        BSONElement res = first;
 
-        BSONObj curr = doc;
         bool stop = false;
         size_t partNum = 0;
-        while ( partNum < path.numParts() && !stop ) {
-
-            res = curr.getField( path.getPart( partNum ) );
+        while ( !stop ) {
 
             switch ( res.type() ) {
 
@@ -50,8 +53,11 @@ namespace mongo {
                 break;
 
             case Object:
-                curr = res.Obj();
                 ++partNum;
+                if ( partNum < path.numParts() )
+                    res = res.Obj().getField( path.getPart( partNum ) );
+                else
+                    stop = true;
                 break;
 
             case Array:
@@ -33,4 +33,10 @@ namespace mongo {
                                        const FieldRef& path,
                                        size_t* idxPath );
 
+    // As above, for a caller that has already looked up the first part of 'path' in the
+    // document and passes the result as 'first'.  'path' must have at least one part.
+    BSONElement getFieldDottedOrArray( const BSONElement& first,
+                                       const FieldRef& path,
+                                       size_t* idxPath );
+
 }  // namespace mongo
@@ -21,6 +21,7 @@
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
+#include "mongo/db/intervalbtreecursor.h"
 #include "mongo/db/query_optimizer.h"
 #include "mongo/db/queryutil.h"
 #include "mongo/util/elapsed_tracker.h"
@@ -77,21 +78,44 @@ namespace mongo {
         }
 
         shared_ptr<Cursor> cursor = getOptimizedCursor( ns, query, BSONObj(), _countPlanPolicies );
+        IntervalBtreeCursor* intervalCursor = dynamic_cast<IntervalBtreeCursor*>( cursor.get() );
         ClientCursorHolder ccPointer;
         ElapsedTracker timeToStartYielding( 256, 20 );
+        int32_t keysSinceYieldCheck = 1;
         try {
             while( cursor->ok() ) {
                 if ( !ccPointer ) {
-                    if ( timeToStartYielding.intervalHasElapsed() ) {
+                    if ( timeToStartYielding.intervalHasElapsed( keysSinceYieldCheck ) ) {
                         // Lazily construct a ClientCursor, avoiding a performance regression when scanning a very
                         // small number of documents.
                         ccPointer.reset( new ClientCursor( QueryOption_NoCursorTimeout, cursor, ns ) );
                     }
                 }
-                else if ( !ccPointer->yieldSometimes( ClientCursor::MaybeCovered ) ||
+                else if ( !ccPointer->yieldSometimes( ClientCursor::MaybeCovered, 0,
+                                                      keysSinceYieldCheck ) ||
                          !cursor->ok() ) {
                     break;
                 }
+
+                if ( intervalCursor && !intervalCursor->matcher() &&
+                     !intervalCursor->isMultiKey() ) {
+                    // Every key in the interval matches, and each is a different document, so
+                    // the keys of a bucket can be counted without stopping at each one.
+                    keysSinceYieldCheck = intervalCursor->advanceInBucket();
+                    long long n = keysSinceYieldCheck;
+                    if ( skip > 0 ) {
+                        long long skipped = std::min( skip, n );
+                        skip -= skipped;
+                        n -= skipped;
+                    }
+                    count += n;
+                    if ( limit > 0 && count >= limit ) {
+                        count = limit;
+                        break;
+                    }
+                    continue;
+                }
+                keysSinceYieldCheck = 1;
                 
                 if ( cursor->currentMatches() && !cursor->getsetdup( cursor->currLoc() ) ) {
                     
@@ -855,8 +855,21 @@ namespace mongo {
         }
 
         //  update in place
+        //  only journal the bytes that changed; for a typical $inc or same size $set this is a few
+        //  bytes rather than the whole document
         int sz = objNew.objsize();
-        memcpy(getDur().writingPtr(toupdate->data(), sz), objNew.objdata(), sz);
+        const char* oldData = toupdate->data();
+        const char* newData = objNew.objdata();
+        int first = 0;
+        while ( first < sz && oldData[first] == newData[first] )
+            first++;
+        if ( first == sz )
+            return dl; // no-op update
+        int last = sz - 1;
+        while ( oldData[last] == newData[last] )
+            last--;
+        int len = last - first + 1;
+        memcpy(getDur().writingPtr(toupdate->data() + first, len), newData + first, len);
         return dl;
     }
 
@@ -919,9 +932,11 @@ namespace mongo {
 
     /** @param o the object to insert. can be modified to add _id and thus be an in/out param
      */
-    DiskLoc DataFileMgr::insertWithObjMod(const char* ns, BSONObj& o, bool mayInterrupt, bool god) {
+    DiskLoc DataFileMgr::insertWithObjMod(const char* ns, BSONObj& o, bool mayInterrupt, bool god,
+                                          BulkInsert* bulk) {
         bool addedID = false;
-        DiskLoc loc = insert( ns, o.objdata(), o.objsize(), mayInterrupt, god, true, &addedID );
+        DiskLoc loc = insert( ns, o.objdata(), o.objsize(), mayInterrupt, god, true, &addedID,
+                              bulk );
         if( addedID && !loc.isNull() )
             o = BSONObj::make( loc.rec() );
         return loc;
@@ -1002,6 +1017,104 @@ namespace mongo {
         return loc;
     }
 
+    BulkInsert::BulkInsert(const char* ns, NamespaceDetails* d)
+        : _ns(ns), _d(d), _deferredIndexes(0), _finished(false) {
+        verify( supported( ns, d ) );
+        // in progress (background) index builds keep the per document path
+        for ( int i = 0; i < d->getCompletedIndexCount(); i++ ) {
+            IndexDetails& id = d->idx(i);
+            bool dupsAllowed = ( !KeyPattern::isIdKeyPattern(id.keyPattern()) && !id.unique() )
+                               || ignoreUniqueIndex(id);
+            if ( dupsAllowed )
+                _deferredIndexes |= 1ULL << i;
+        }
+    }
+
+    BulkInsert::~BulkInsert() {
+        if ( _finished )
+            return;
+        try {
+            finish();
+        }
+        catch ( DBException& e ) {
+            problem() << "BulkInsert: couldn't finish inserts into " << _ns << ": " << e << endl;
+        }
+    }
+
+    bool BulkInsert::supported(const char* ns, NamespaceDetails* d) {
+        return d &&
+            !d->isCapped() &&
+            NamespaceString::normal( ns ) &&
+            !strstr( ns, ".system." );
+    }
+
+    int BulkInsert::allocationSpace(int lenWHdr) {
+        // same alignment and quantization as NamespaceDetails::alloc()
+        return NamespaceDetails::quantizeAllocationSpace( ( lenWHdr + 3 ) & 0xfffffffc );
+    }
+
+    int BulkInsert::spaceFor(const char* ns, NamespaceDetails* d, const BSONObj& obj) {
+        int len = obj.objsize();
+        // as in DataFileMgr::insert(), which only adds an _id for user inserts like these
+        if ( obj["_id"].eoo() && nsToDatabase( ns ) != "local" && d->haveIdIndex() )
+            len += IDToInsert().size();
+        return allocationSpace( d->getRecordAllocationSize( len + Record::HeaderSize ) );
+    }
+
+    void BulkInsert::reserve(int lenWHdr) {
+        verify( _reserved.isNull() );
+        _reserved = allocateSpaceForANewRecord( _ns, _d, lenWHdr, false );
+    }
+
+    DiskLoc BulkInsert::take(int lenWHdr) {
+        if ( _reserved.isNull() )
+            return DiskLoc();
+
+        lenWHdr = allocationSpace( lenWHdr );
+
+        DeletedRecord* r = _reserved.drec();
+        const int regionlen = r->lengthWithHeaders();
+        if ( lenWHdr > regionlen )
+            return DiskLoc();
+
+        DiskLoc loc = _reserved;
+        const int left = regionlen - lenWHdr;
+        if ( left < 24 ) {
+            // you get the whole thing.
+            _reserved.Null();
+            return loc;
+        }
+
+        getDur().writingInt(r->lengthWithHeaders()) = lenWHdr;
+        _reserved.inc(lenWHdr);
+        DeletedRecord* rest = getDur().writing( DataFileMgr::getDeletedRecord(_reserved) );
+        rest->extentOfs() = r->extentOfs();
+        rest->lengthWithHeaders() = left;
+        rest->nextDeleted().Null();
+        return loc;
+    }
+
+    void BulkInsert::releaseReserved() {
+        if ( _reserved.isNull() )
+            return;
+        _d->addDeletedRec( _reserved.drec(), _reserved );
+        _reserved.Null();
+    }
+
+    void BulkInsert::finish() {
+        verify( !_finished );
+        _finished = true;
+        releaseReserved();
+
+        if ( _locs.empty() )
+            return;
+
+        for ( int i = 0; i < _d->getCompletedIndexCount(); i++ ) {
+            if ( defersIndex(i) )
+                indexRecordsBulk( _d, i, _locs );
+        }
+    }
+
     bool NOINLINE_DECL insert_checkSys(const char *sys, const char *ns, bool& wouldAddIndex, const void *obuf, bool god) {
         uassert( 10095 , "attempt to insert in reserved database name 'system'", sys != ns);
         if ( strstr(ns, ".system.") ) {
@@ -1176,7 +1289,8 @@ namespace mongo {
                                 bool mayInterrupt,
                                 bool god,
                                 bool mayAddIndex,
-                                bool* addedID) {
+                                bool* addedID,
+                                BulkInsert* bulk) {
         bool wouldAddIndex = false;
         massert( 10093 , "cannot insert into reserved $ collection", god || NamespaceString::normal( ns ) );
         uassert( 10094 , str::stream() << "invalid ns: " << ns , isValidNS( ns ) );
@@ -1251,7 +1365,11 @@ namespace mongo {
             checkNoIndexConflicts( d, BSONObj( reinterpret_cast<const char *>( obuf ) ) );
         }
 
-        DiskLoc loc = allocateSpaceForANewRecord(ns, d, lenWHdr, god);
+        DiskLoc loc;
+        if ( bulk )
+            loc = bulk->take(lenWHdr);
+        if ( loc.isNull() )
+            loc = allocateSpaceForANewRecord(ns, d, lenWHdr, god);
 
         if ( loc.isNull() ) {
             log() << "insert: couldn't alloc space for object ns:" << ns
@@ -1293,7 +1411,7 @@ namespace mongo {
         if ( d->getTotalIndexCount() > 0 ) {
             try {
                 BSONObj obj(r->data());
-                indexRecord(ns, d, obj, loc);
+                indexRecord(ns, d, obj, loc, bulk);
             }
             catch( AssertionException& e ) {
                 // should be a dup key error on _id index
@@ -1314,6 +1432,9 @@ namespace mongo {
 
         d->paddingFits();
 
+        if ( bulk )
+            bulk->inserted(loc);
+
         return loc;
     }
 
@@ -1367,6 +1488,82 @@ namespace mongo {
         return r;
     }
 
+    void DataFileMgr::fast_oplog_insert(NamespaceDetails *d, const char *ns,
+                                        const vector<int>& lens, vector<Record*>* records) {
+        verify( d );
+        DEV verify( d == nsdetails(ns) );
+        massert( 17057,
+                 str::stream()
+                 << "fast_oplog_insert requires a capped collection "
+                 << " but " << ns << " is not capped",
+                 d->isCapped() );
+
+        Timer timer;
+
+        // a capped allocation has to fit in one extent, and makes room by deleting the oldest
+        // records, so don't take too much at once.  a run always has at least one record.
+        const int maxRunLen = d->lastExtentSize() / 8;
+
+        size_t i = 0;
+        while ( i < lens.size() ) {
+            // same alignment as NamespaceDetails::alloc(), which then doesn't change the total
+            int runLen = 0;
+            size_t end = i;
+            while ( end < lens.size() ) {
+                int lenWHdr = ( lens[end] + Record::HeaderSize + 3 ) & 0xfffffffc;
+                if ( end > i && runLen + lenWHdr > maxRunLen )
+                    break;
+                runLen += lenWHdr;
+                end++;
+            }
+
+            DiskLoc loc = d->alloc(ns, runLen);
+            verify( !loc.isNull() );
+
+            Record *first = loc.rec();
+            verify( first->lengthWithHeaders() == runLen );
+            const int extentOfs = first->extentOfs();
+            Extent *e = first->myExtent(loc);
+
+            const DiskLoc prevLast = e->lastRecord;
+            if ( prevLast.isNull() )
+                getDur().writing( e->fl() )->firstRecord = loc;
+            else
+                getDur().writingInt( prevLast.rec()->nextOfs() ) = loc.getOfs();
+
+            char *p = static_cast<char*>( getDur().writingPtr( first, runLen ) );
+            int ofs = loc.getOfs();
+            int prevOfs = prevLast.isNull() ? DiskLoc::NullOfs : prevLast.getOfs();
+            long long dataSize = 0;
+            const long long numRecords = end - i;
+            for ( ; i < end; i++ ) {
+                int lenWHdr = ( lens[i] + Record::HeaderSize + 3 ) & 0xfffffffc;
+                Record *r = reinterpret_cast<Record*>( p );
+                r->lengthWithHeaders() = lenWHdr;
+                r->extentOfs() = extentOfs;
+                r->prevOfs() = prevOfs;
+                r->nextOfs() = ( i + 1 == end ) ? DiskLoc::NullOfs : ofs + lenWHdr;
+                records->push_back( r );
+                dataSize += r->netLength();
+
+                prevOfs = ofs;
+                ofs += lenWHdr;
+                p += lenWHdr;
+            }
+
+            e->lastRecord.writing() = DiskLoc( loc.a(), prevOfs );
+            d->incrementStats( dataSize, numRecords );
+        }
+
+        if ( NamespaceString::oplog(ns) ) {
+            oplogInsertStats.recordMillis( timer.millis(), lens.size() );
+            long long bytes = 0;
+            for ( size_t j = 0; j < lens.size(); j++ )
+                bytes += lens[j];
+            oplogInsertBytesStats.increment( bytes );
+        }
+    }
+
 } // namespace mongo
 
 #include "clientcursor.h"
@@ -44,6 +44,7 @@
 
 namespace mongo {
 
+    class BulkInsert;
     class Cursor;
     class DataFileHeader;
     class Extent;
@@ -93,11 +94,13 @@ namespace mongo {
          * note: does NOT put on oplog
          * @param o both and in and out param
          * @param mayInterrupt When true, killop may interrupt the function call.
+         * @param bulk see insert()
          */
         DiskLoc insertWithObjMod(const char* ns,
                                  BSONObj& /*out*/o,
                                  bool mayInterrupt = false,
-                                 bool god = false);
+                                 bool god = false,
+                                 BulkInsert* bulk = 0);
 
         /**
          * Insert the contents of @param buf with length @param len into namespace @param ns.
@@ -109,6 +112,8 @@ namespace mongo {
          *     command.
          * @param addedID if not null, set to true if adding _id element.  You must assure false
          *     before calling if using.
+         * @param bulk if not null, the record is allocated from the batch's reserved space and
+         *     keys for the indexes it defers are added later by BulkInsert::finish().
          */
         DiskLoc insert(const char* ns,
                        const void* buf,
@@ -116,7 +121,8 @@ namespace mongo {
                        bool mayInterrupt = false,
                        bool god = false,
                        bool mayAddIndex = true,
-                       bool* addedID = 0);
+                       bool* addedID = 0,
+                       BulkInsert* bulk = 0);
         static shared_ptr<Cursor> findAll(const StringData& ns, const DiskLoc &startLoc = DiskLoc());
 
         /* special version of insert for transaction logging -- streamlined a bit.
@@ -125,6 +131,13 @@ namespace mongo {
         */
         Record* fast_oplog_insert(NamespaceDetails *d, const char *ns, int len);
 
+        /* fast_oplog_insert() of several records at once, 'lens' being their data lengths.
+           consecutive records are carved out of one allocation and declared as written with one
+           intent, which also covers their data: the caller fills in records[i]->data() directly.
+        */
+        void fast_oplog_insert(NamespaceDetails *d, const char *ns, const vector<int>& lens,
+                               vector<Record*>* records);
+
         static Extent* getExtent(const DiskLoc& dl);
         static Record* getRecord(const DiskLoc& dl);
         static DeletedRecord* getDeletedRecord(const DiskLoc& dl);
@@ -430,6 +443,66 @@ namespace mongo {
 
     void addRecordToRecListInExtent(Record* r, DiskLoc loc);
 
+    /**
+     * State shared by the inserts of one chunk of a multi-document insert (see insertMulti()).
+     *
+     * Space for the whole chunk is reserved with a single allocation and each record is carved
+     * off the front of it, so a chunk does one free list search (or extent allocation) rather
+     * than one per document.
+     *
+     * Keys for indexes that allow duplicates can't make an insert fail, so they are held back
+     * and added by finish(), one index at a time and in key order.  Unique indexes are still
+     * maintained per document so that a duplicate key only fails the document that caused it.
+     *
+     * Until finish() the records are missing from the deferred indexes, so it must be called
+     * before the write lock is released or the next group commit.
+     */
+    class BulkInsert : boost::noncopyable {
+    public:
+        BulkInsert(const char* ns, NamespaceDetails* d);
+        ~BulkInsert();
+
+        /** @return true if inserts into this collection can be batched */
+        static bool supported(const char* ns, NamespaceDetails* d);
+
+        /**
+         * @return the space take() will use for 'obj', including the _id DataFileMgr::insert()
+         *         adds if it has none.  Add these up to get the size to reserve().
+         */
+        static int spaceFor(const char* ns, NamespaceDetails* d, const BSONObj& obj);
+
+        /** reserve space for records totalling 'lenWHdr' bytes, including headers */
+        void reserve(int lenWHdr);
+
+        /** @return a record of at least 'lenWHdr' bytes from the reserved space, or null if full */
+        DiskLoc take(int lenWHdr);
+
+        /** @return true if keys for index 'idxNo' are added by finish() */
+        bool defersIndex(int idxNo) const { return _deferredIndexes & ( 1ULL << idxNo ); }
+
+        /** called by DataFileMgr::insert() once the record is in all non deferred indexes */
+        void inserted(const DiskLoc& loc) { _locs.push_back(loc); }
+
+        /** the records inserted so far, in insertion order */
+        const vector<DiskLoc>& insertedLocs() const { return _locs; }
+
+        /** add the deferred index keys and return unused reserved space to the free list */
+        void finish();
+
+    private:
+        /** @return 'lenWHdr' aligned and quantized as NamespaceDetails::alloc() would */
+        static int allocationSpace(int lenWHdr);
+
+        void releaseReserved();
+
+        const char* _ns;
+        NamespaceDetails* _d;
+        unsigned long long _deferredIndexes; // bit per index number
+        DiskLoc _reserved;                   // a DeletedRecord not on any free list
+        vector<DiskLoc> _locs;
+        bool _finished;
+    };
+
     /**
      * Static helpers to manipulate the list of unfinished index builds.
      */
@@ -33,6 +33,11 @@ namespace mongo {
             processInternal(input, merging);
         }
 
+        /** Process n inputs in a row, all for this accumulator's group. */
+        void processBatch(const Value* inputs, size_t n, bool merging) {
+            processBatchInternal(inputs, n, merging);
+        }
+
         /** Marks the end of the evaluate() phase and return accumulated result.
          *  toBeMerged should be true when the outputs will be merged by process().
          */
@@ -55,6 +60,13 @@ namespace mongo {
         /// Update subclass's internal state based on input
         virtual void processInternal(const Value& input, bool merging) = 0;
 
+        /// Subclasses with a cheaper loop than one processInternal() call per input override this
+        virtual void processBatchInternal(const Value* inputs, size_t n, bool merging) {
+            for (size_t i = 0; i < n; i++) {
+                processInternal(inputs[i], merging);
+            }
+        }
+
         /// subclasses are expected to update this as necessary
         int _memUsageBytes;
     };
@@ -111,6 +123,7 @@ namespace mongo {
     class AccumulatorSum : public Accumulator {
     public:
         virtual void processInternal(const Value& input, bool merging);
+        virtual void processBatchInternal(const Value* inputs, size_t n, bool merging);
         virtual Value getValue(bool toBeMerged) const;
         virtual const char* getOpName() const;
         virtual void reset();
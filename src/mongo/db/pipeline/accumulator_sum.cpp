@@ -46,6 +46,18 @@ namespace mongo {
         count++;
     }
 
+    void AccumulatorSum::processBatchInternal(const Value* inputs, size_t n, bool merging) {
+        // AccumulatorAvg merges differently, so only skip the virtual calls when not merging
+        if (merging) {
+            Accumulator::processBatchInternal(inputs, n, merging);
+            return;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            AccumulatorSum::processInternal(inputs[i], merging);
+        }
+    }
+
     intrusive_ptr<Accumulator> AccumulatorSum::create() {
         return new AccumulatorSum();
     }
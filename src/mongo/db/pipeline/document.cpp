@@ -54,10 +54,53 @@ namespace mongo {
             }
         }
 
+        // the field may not have been converted from our BSONObj yet
+        while (_bsonNext) {
+            const Position pos = loadNextField();
+            const ValueElement& elem = getField(pos);
+            if (elem.nameLen == reqSize
+                && memcmp(requested.rawData(), elem._name, reqSize) == 0) {
+                return pos;
+            }
+        }
+
         // if we got here, there's no such field
         return Position();
     }
 
+    void DocumentStorage::setLazyBson(const BSONObj& bson) {
+        verify(!_buffer);
+        dassert(bson.isOwned());
+
+        _bson = bson;
+        _bsonNext = bson.isEmpty() ? NULL : bson.firstElement().rawdata();
+        _bsonUnmodified = true;
+    }
+
+    Position DocumentStorage::loadNextField() const {
+        dassert(_bsonNext);
+
+        // Loading doesn't change the contents of the document, only how much of it is converted.
+        DocumentStorage& self = const_cast<DocumentStorage&>(*this);
+
+        const BSONElement elem(_bsonNext);
+        const Value value(elem);
+
+        self._bsonNext += elem.size();
+        if (*self._bsonNext == EOO)
+            self._bsonNext = NULL;
+
+        const Position pos(_usedBytes);
+        self.appendField(StringData(elem.fieldName(), elem.fieldNameSize()-1)) = value;
+        return pos;
+    }
+
+    void DocumentStorage::detachBson() {
+        loadAllFields();
+        _bsonUnmodified = false;
+        _bson = BSONObj();
+    }
+
     Value& DocumentStorage::appendField(StringData name) {
         Position pos = getNextPosition();
         const int nameSize = name.size();
@@ -170,6 +213,8 @@ namespace mongo {
     }
 
     intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
+        loadAllFields(); // the clone isn't backed by our BSONObj
+
         intrusive_ptr<DocumentStorage> out (new DocumentStorage());
 
         // Make a copy of the buffer.
@@ -212,6 +257,12 @@ namespace mongo {
         *this = md.freeze();
     }
 
+    Document Document::lazyFromBson(const BSONObj& bson) {
+        intrusive_ptr<DocumentStorage> storage(new DocumentStorage());
+        storage->setLazyBson(bson.getOwned());
+        return Document(storage.get());
+    }
+
     BSONObjBuilder& operator << (BSONObjBuilderValueStream& builder, const Document& doc) {
         BSONObjBuilder subobj(builder.subobjStart());
         doc.toBson(&subobj);
@@ -220,6 +271,12 @@ namespace mongo {
     }
 
     void Document::toBson(BSONObjBuilder* pBuilder) const {
+        if (storage().hasUnmodifiedBson()) {
+            // converting each field back would give the same bytes
+            pBuilder->appendElements(storage().getBson());
+            return;
+        }
+
         for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
             *pBuilder << it->nameSD() << it->val;
         }
@@ -310,6 +367,11 @@ namespace mongo {
         size_t size = sizeof(DocumentStorage);
         size += storage().allocatedBytes();
 
+        if (storage().hasLazyFields()) {
+            // don't convert the fields just to size them
+            return size + storage().getBson().objsize();
+        }
+
         for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
             size += it->val.getApproximateSize();
             size -= sizeof(Value); // already accounted for above
@@ -393,4 +455,42 @@ namespace mongo {
         }
         return doc.freeze();
     }
+
+    void DocumentBatch::reset(const vector<string>& fieldNames) {
+        if (fieldNames != _fieldNames) {
+            _fieldNames = fieldNames;
+            _columns.clear();
+            _columns.resize(_fieldNames.size());
+
+            MutableDocument columnIndex(_fieldNames.size());
+            for (size_t i = 0; i < _fieldNames.size(); i++) {
+                columnIndex.addField(_fieldNames[i], Value(static_cast<int>(i)));
+            }
+            _columnIndex = columnIndex.freeze();
+        }
+
+        for (size_t i = 0; i < _columns.size(); i++) {
+            _columns[i].clear();
+        }
+        _size = 0;
+    }
+
+    size_t DocumentBatch::addDocument() {
+        for (size_t i = 0; i < _columns.size(); i++) {
+            _columns[i].push_back(Value());
+        }
+        return _size++;
+    }
+
+    Document DocumentBatch::getDocument(size_t document) const {
+        dassert(document < _size);
+
+        MutableDocument out(_columns.size());
+        for (size_t i = 0; i < _columns.size(); i++) {
+            const Value& value = _columns[i][document];
+            if (!value.missing())
+                out.addField(_fieldNames[i], value);
+        }
+        return out.freeze();
+    }
 }
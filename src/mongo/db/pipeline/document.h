@@ -59,6 +59,12 @@ namespace mongo {
         /// Create a new Document deep-converted from the given BSONObj.
         explicit Document(const BSONObj& bson);
 
+        /** Create a Document that holds a copy of bson (none if it is owned) and converts its
+         *  fields only when they are first looked up, or all of them when the Document is
+         *  iterated or modified.  As long as it is unmodified, toBson() copies the BSONObj.
+         */
+        static Document lazyFromBson(const BSONObj& bson);
+
         void swap(Document& rhs) { _storage.swap(rhs._storage); }
 
         /// Look up a field by key name. Returns Value() if no such field. O(1)
@@ -82,7 +88,10 @@ namespace mongo {
         size_t size() const { return storage().size(); }
 
         /// True if this document has no fields.
-        bool empty() const { return !_storage || storage().iterator().atEnd(); }
+        bool empty() const {
+            // a field still to be converted is never missing
+            return !_storage || (!storage().hasLazyFields() && storage().iterator().atEnd());
+        }
 
         /// Create a new FieldIterator that can be used to examine the Document's fields in order.
         FieldIterator fieldIterator() const;
@@ -370,7 +379,9 @@ namespace mongo {
                 return clonedStorage();
 
             // This function exists to ensure this is safe
-            return const_cast<DocumentStorage&>(*storagePtr());
+            DocumentStorage& storage = const_cast<DocumentStorage&>(*storagePtr());
+            storage.prepareForWrite();
+            return storage;
         }
         DocumentStorage& newStorage() {
             reset(new DocumentStorage);
@@ -423,6 +434,55 @@ namespace mongo {
         DocumentStorageIterator _it;
     };
 
+    /** A block of documents stored by column: one vector of Values for each top-level field.
+     *
+     *  This lets a consumer such as $group read a field for a whole block of documents without
+     *  building a DocumentStorage or doing a hash lookup per document.  Only the fields that
+     *  were asked for when the batch was reset are kept; a field a document doesn't have is a
+     *  missing Value in its column.  Documents are only materialized by getDocument(), which
+     *  returns the fields in column order rather than their original order.
+     */
+    class DocumentBatch : boost::noncopyable {
+    public:
+        DocumentBatch() : _size(0) {}
+
+        /// Empty the batch and set its columns. Keeps the allocated columns if they are unchanged.
+        void reset(const vector<string>& fieldNames);
+
+        /// Number of documents in the batch.
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        size_t numColumns() const { return _fieldNames.size(); }
+        const string& getFieldName(size_t column) const { return _fieldNames[column]; }
+
+        /// Returns the column holding the given top-level field, or -1 if there isn't one.
+        int findColumn(StringData fieldName) const {
+            const Value column = _columnIndex[fieldName];
+            return column.missing() ? -1 : column.getInt();
+        }
+
+        /// The values of one field for every document in the batch, indexed by document.
+        const vector<Value>& getColumn(size_t column) const { return _columns[column]; }
+
+        /// Appends a document with every field missing and returns its index.
+        size_t addDocument();
+
+        /// Sets a field of a document added by addDocument().
+        void setField(size_t document, size_t column, const Value& value) {
+            _columns[column][document] = value;
+        }
+
+        /// Builds one document of the batch, leaving out its missing fields.
+        Document getDocument(size_t document) const;
+
+    private:
+        vector<string> _fieldNames;
+        Document _columnIndex; // field name -> column number, for O(1) findColumn()
+        vector<vector<Value> > _columns;
+        size_t _size;
+    };
+
     /// Macro to create Document literals. Syntax is the same as the BSON("name" << 123) macro.
 #define DOC(fields) ((DocumentStream() << fields).done())
 
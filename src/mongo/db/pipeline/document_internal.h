@@ -145,7 +145,14 @@ namespace mongo {
         bool _includeMissing;
     };
 
-    /// Storage class used by both Document and MutableDocument
+    /** Storage class used by both Document and MutableDocument
+     *
+     *  A DocumentStorage can also be backed by a BSONObj (see setLazyBson()), in which case the
+     *  fields of the BSONObj are converted to Values in order, only as far as a lookup or an
+     *  iteration needs them.  Since fields are only ever appended the Position of a field never
+     *  changes.  Loading mutates the storage behind a const Document, so like everything else
+     *  about Documents it isn't safe to read one from several threads at once.
+     */
     class DocumentStorage :  public RefCountable {
     public:
         // Note: default constructor should zero-init to support emptyDoc()
@@ -154,6 +161,8 @@ namespace mongo {
                           , _usedBytes(0)
                           , _numFields(0)
                           , _hashTabMask(0)
+                          , _bsonNext(NULL)
+                          , _bsonUnmodified(false)
         {}
         ~DocumentStorage();
 
@@ -210,10 +219,11 @@ namespace mongo {
 
         /// This skips missing values
         DocumentStorageIterator iterator() const {
+            loadAllFields();
             return DocumentStorageIterator(_firstElement, end(), false);
         }
 
-        /// This includes missing values
+        /// This includes missing values. Only sees the fields of a lazy BSONObj loaded so far.
         DocumentStorageIterator iteratorAll() const {
             return DocumentStorageIterator(_firstElement, end(), true);
         }
@@ -225,7 +235,36 @@ namespace mongo {
             return !_buffer ? 0 : (_bufferEnd - _buffer + hashTabBytes());
         }
 
+        /** Back this empty storage with bson, which must be owned.  Its fields are added to the
+         *  storage as they are needed.
+         */
+        void setLazyBson(const BSONObj& bson);
+
+        /// True if some fields of the BSONObj this was created from haven't been converted yet.
+        bool hasLazyFields() const { return _bsonNext; }
+
+        /** True if this holds exactly the fields of the BSONObj it was created from, which is
+         *  then returned by getBson().
+         */
+        bool hasUnmodifiedBson() const { return _bsonUnmodified; }
+        const BSONObj& getBson() const { return _bson; }
+
+        /// MutableDocument calls this before any change: loads the rest and forgets the BSONObj.
+        void prepareForWrite() {
+            if (MONGO_unlikely(_bsonNext || _bsonUnmodified))
+                detachBson();
+        }
+
     private:
+        void detachBson();
+
+        void loadAllFields() const {
+            while (MONGO_unlikely(_bsonNext))
+                loadNextField();
+        }
+
+        /// Converts the next field of the BSONObj and returns its Position.
+        Position loadNextField() const;
 
         /// Same as lastElement->next() or firstElement() if empty.
         const ValueElement* end() const { return _firstElement->plusBytes(_usedBytes); }
@@ -293,6 +332,12 @@ namespace mongo {
         unsigned _usedBytes; // position where next field would start
         unsigned _numFields; // this includes removed fields
         unsigned _hashTabMask; // equal to hashTabBuckets()-1 but used more often
+
+        // Only used for storage backed by a BSONObj, see setLazyBson().
+        BSONObj _bson;
+        const char* _bsonNext; // next element of _bson to convert, NULL once all are
+        bool _bsonUnmodified; // nothing but _bson's fields were ever added
+
         // When adding a field, make sure to update clone() method
     };
 }
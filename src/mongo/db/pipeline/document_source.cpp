@@ -47,6 +47,12 @@ namespace mongo {
     void DocumentSource::optimize() {
     }
 
+    bool DocumentSource::getNextBatch(DocumentBatch* pBatch) {
+        // only sources that override producesBatches() should be asked for batches
+        verify(false);
+        return false;
+    }
+
     void DocumentSource::dispose() {
         if ( pSource ) {
             // This is required for the DocumentSourceCursor to release its read lock, see
@@ -154,6 +160,28 @@ namespace mongo {
         return Value::consume(values);
     }
 
+    Value DocumentSource::valueFromBsonWithDeps(const BSONElement& bsonElement,
+                                                const Value& isNeeded) {
+        if (isNeeded.missing())
+            return Value();
+
+        if (isNeeded.getType() == Bool)
+            return Value(bsonElement);
+
+        dassert(isNeeded.getType() == Object);
+
+        if (bsonElement.type() == Object) {
+            Document sub = documentFromBsonWithDeps(bsonElement.embeddedObject(),
+                                                    isNeeded.getDocument());
+            return Value(sub);
+        }
+
+        if (bsonElement.type() == Array)
+            return arrayHelper(bsonElement.embeddedObject(), isNeeded.getDocument());
+
+        return Value();
+    }
+
     Document DocumentSource::documentFromBsonWithDeps(const BSONObj& bson,
                                                       const ParsedDeps& neededFields) {
         MutableDocument md(neededFields.size());
@@ -162,28 +190,10 @@ namespace mongo {
         while (it.more()) {
             BSONElement bsonElement (it.next());
             StringData fieldName (bsonElement.fieldName(), bsonElement.fieldNameSize()-1);
-            Value isNeeded = neededFields[fieldName];
 
-            if (isNeeded.missing())
-                continue;
-
-            if (isNeeded.getType() == Bool) {
-                md.addField(fieldName, Value(bsonElement));
-                continue;
-            }
-
-            dassert(isNeeded.getType() == Object);
-
-            if (bsonElement.type() == Object) {
-                Document sub = documentFromBsonWithDeps(bsonElement.embeddedObject(),
-                                                        isNeeded.getDocument());
-                md.addField(fieldName, Value(sub));
-            }
-
-            if (bsonElement.type() == Array) {
-                md.addField(fieldName, arrayHelper(bsonElement.embeddedObject(),
-                                                   isNeeded.getDocument()));
-            }
+            Value value = valueFromBsonWithDeps(bsonElement, neededFields[fieldName]);
+            if (!value.missing())
+                md.addField(fieldName, value);
         }
 
         return md.freeze();
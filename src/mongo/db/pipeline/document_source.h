@@ -43,6 +43,7 @@ namespace mongo {
     class ExpressionFieldPath;
     class ExpressionObject;
     class DocumentSourceLimit;
+    class Pipeline;
 
     class DocumentSource : public IntrusiveCounterUnsigned {
     public:
@@ -69,6 +70,18 @@ namespace mongo {
          */
         virtual boost::optional<Document> getNext() = 0;
 
+        /** True if this source can also return its output a block at a time in columnar form,
+         *  through getNextBatch().  A consumer must use either getNext() or getNextBatch(), not
+         *  both.  The default is false.
+         */
+        virtual bool producesBatches() const { return false; }
+
+        /** Replaces the contents of pBatch with the next block of documents.  Returns false once
+         *  there are no more.  Only called if producesBatches() is true.
+         *  Subclasses must call pExpCtx->checkForInterupt().
+         */
+        virtual bool getNextBatch(DocumentBatch* pBatch);
+
         /**
          * Inform the source that it is no longer needed and may release its resources.  After
          * dispose() is called the source must still be able to handle iteration requests, but may
@@ -158,6 +171,11 @@ namespace mongo {
         static ParsedDeps parseDeps(const set<string>& deps);
         static Document documentFromBsonWithDeps(const BSONObj& object, const ParsedDeps& deps);
 
+        /** The value documentFromBsonWithDeps() would give a top-level field, where isNeeded is
+         *  that field's entry in the ParsedDeps.  Missing if the field isn't needed.
+         */
+        static Value valueFromBsonWithDeps(const BSONElement& element, const Value& isNeeded);
+
         /**
           Add the DocumentSource to the array builder.
 
@@ -337,6 +355,12 @@ namespace mongo {
             const ShardOutput& shardOutput,
             const intrusive_ptr<ExpressionContext>& pExpCtx);
 
+        /**
+          Check each shard's result and return its result array.  Used when
+          the shards' outputs are merged rather than concatenated.
+         */
+        vector<BSONArray> getArrays();
+
     protected:
         // virtuals from DocumentSource
         virtual void sourceToBson(BSONObjBuilder *pBuilder, bool explain) const;
@@ -354,6 +378,9 @@ namespace mongo {
          */
         void getNextDocument();
 
+        /// uasserts if the shard failed, otherwise returns its result array
+        static BSONArray checkResult(const Strategy::CommandResult& shardResult);
+
         bool unstarted;
         bool hasCurrent;
         bool newSource; // set to true for the first item of a new source
@@ -374,6 +401,8 @@ namespace mongo {
         // virtuals from DocumentSource
         virtual ~DocumentSourceCursor();
         virtual boost::optional<Document> getNext();
+        virtual bool producesBatches() const;
+        virtual bool getNextBatch(DocumentBatch* pBatch);
         virtual void setSource(DocumentSource *pSource);
         virtual bool coalesce(const intrusive_ptr<DocumentSource>& nextSource);
         virtual bool isValidInitialSource() const { return true; }
@@ -436,6 +465,9 @@ namespace mongo {
          */
         void setSort(const BSONObj& sort) { _sort = sort; }
 
+        /// the sort recorded with setSort(), empty if the cursor isn't sorted
+        const BSONObj& getSort() const { return _sort; }
+
         void setProjection(const BSONObj& projection, const ParsedDeps& deps);
 
         /// returns -1 for no limit
@@ -450,7 +482,11 @@ namespace mongo {
             CursorId cursorId,
             const intrusive_ptr<ExpressionContext> &pExpCtx);
 
-        void loadBatch();
+        /** Reads documents into _currentBatch, or into pColumns if it isn't NULL. */
+        void loadBatch(DocumentBatch* pColumns = NULL);
+
+        /** Adds the fields of obj that are in _dependencies to a new document in pColumns. */
+        void appendToColumns(DocumentBatch* pColumns, const BSONObj& obj) const;
 
         std::deque<Document> _currentBatch;
 
@@ -459,6 +495,7 @@ namespace mongo {
         BSONObj _sort;
         shared_ptr<Projection> _projection; // shared with pClientCursor
         ParsedDeps _dependencies;
+        vector<string> _columnNames; // top-level fields of _dependencies, for getNextBatch()
         intrusive_ptr<DocumentSourceLimit> _limit;
         long long _docsAddedToBatches; // for _limit enforcement
 
@@ -480,6 +517,77 @@ namespace mongo {
     };
 
 
+    /**
+     * Runs the shard half of a split pipeline on several threads inside one mongod.
+     *
+     * The input (normally a DocumentSourceCursor) is read on the calling thread, since it holds
+     * the read lock, and handed out in batches to a copy of the shard pipeline per worker thread.
+     * The shard pipeline ends with the partial $group, so what comes out of this source is the
+     * partial groups of every worker, to be combined by the merging half of the pipeline just as
+     * if they had come from different shards.
+     */
+    class DocumentSourceParallel :
+        public DocumentSource {
+    public:
+        // virtuals from DocumentSource
+        virtual ~DocumentSourceParallel();
+        virtual boost::optional<Document> getNext();
+        virtual void setSource(DocumentSource *pSource);
+        virtual bool isValidInitialSource() const { return true; }
+        virtual void dispose();
+
+        /**
+         * @param input the source to read documents from
+         * @param shardPipeline the stages to run on each worker, as returned by
+         *        Pipeline::splitForSharded(); it is copied for each worker
+         * @param nWorkers number of worker threads, as reserved by reserveWorkers(); the new
+         *        source releases them when it is destroyed, even if create() throws
+         * @param pExpCtx the expression context for the merging pipeline
+         */
+        static intrusive_ptr<DocumentSourceParallel> create(
+            const intrusive_ptr<DocumentSource>& input,
+            const intrusive_ptr<Pipeline>& shardPipeline,
+            int nWorkers,
+            const intrusive_ptr<ExpressionContext>& pExpCtx);
+
+        /**
+         * Reserves up to 'wanted' worker threads out of a limit shared by every aggregation
+         * running on this server.  Returns how many were reserved, 0 if fewer than two were
+         * available since there is no point running one worker.  They must be passed to
+         * create() or given back with releaseWorkers().
+         */
+        static int reserveWorkers(int wanted);
+        static void releaseWorkers(int nWorkers);
+
+        /// Queue of input batches shared by the reading thread and the workers.
+        class Feed;
+
+    protected:
+        // virtuals from DocumentSource
+        virtual void sourceToBson(BSONObjBuilder *pBuilder, bool explain) const;
+
+    private:
+        DocumentSourceParallel(const intrusive_ptr<DocumentSource>& input,
+                               int reservedWorkers,
+                               const intrusive_ptr<ExpressionContext>& pExpCtx);
+
+        /// Feeds all of _input to the workers and waits for them to finish.
+        void run();
+
+        intrusive_ptr<DocumentSource> _input;
+        BSONObj _shardSpec; // the shard pipeline as a command, for explain
+        vector<intrusive_ptr<Pipeline> > _workers;
+        vector<intrusive_ptr<DocumentSource> > _workerInputs; // parallel to _workers
+        shared_ptr<Feed> _feed;
+        const int _reservedWorkers; // released in the destructor
+
+        bool _ran;
+        vector<vector<Document> > _results; // one per worker
+        size_t _currentWorker;
+        size_t _currentResult;
+    };
+
+
     /*
       This contains all the basic mechanics for filtering a stream of
       Documents, except for the actual predicate evaluation itself.  This was
@@ -531,6 +639,7 @@ namespace mongo {
         virtual const char *getSourceName() const;
         virtual GetDepsReturn getDependencies(set<string>& deps) const;
         virtual void dispose();
+        virtual void optimize();
 
         /**
           Create a new grouping DocumentSource.
@@ -571,6 +680,12 @@ namespace mongo {
         /// Tell this source if it is doing a merge from shards. Defaults to false.
         void setDoingMerge(bool doingMerge) { _doingMerge = doingMerge; }
 
+        /**
+         * True if any accumulator's result depends on the order of its input, as $first, $last
+         * and $push do.  Such a $group can't take its input split between several threads.
+         */
+        bool dependsOnInputOrder() const;
+
         /**
           Create a grouping DocumentSource from BSON.
 
@@ -599,8 +714,39 @@ namespace mongo {
     private:
         DocumentSourceGroup(const intrusive_ptr<ExpressionContext> &pExpCtx);
 
-        /// Spill groups map to disk and returns an iterator to the file.
-        shared_ptr<Sorter<Value, Value>::Iterator> spill();
+        typedef vector<intrusive_ptr<Accumulator> > Accumulators;
+        typedef boost::unordered_map<Value, Accumulators, Value::Hash> GroupsMap;
+
+        /*
+          Groups are hash partitioned on their _id.  When we run out of
+          memory only the largest partitions are spilled, each as a sorted
+          run of (_id, mergeable accumulator state).  Partitions that never
+          spilled are returned straight from memory; the spilled ones are
+          then read back and re-aggregated one partition at a time.
+         */
+        struct Partition {
+            Partition();
+
+            GroupsMap groups;
+            long long memoryUsageBytes;
+            long long spilledBytes; // approximate, in memory size of what was spilled
+            vector<shared_ptr<Sorter<Value, Value>::Iterator> > spills;
+        };
+
+        static const size_t numPartitions = 16;
+        static size_t partitionFor(const Value& id);
+
+        /// Spill a partition's groups to disk as one sorted run and free them.
+        void spill(Partition& partition);
+
+        /// Spill the largest partitions until we are back under half of the memory limit.
+        void spillLargestPartitions();
+
+        /// Get ready to return the groups of _partitions[_outputOrder[_outputPosition]].
+        void startPartition();
+
+        /// Returns the next group from the spilled partition being merged by _sorterIterator.
+        Document getNextSorted();
 
         // Only used by spill. Would be function-local if that were legal in C++03.
         class SpillSTLComparator;
@@ -614,11 +760,31 @@ namespace mongo {
         void populate();
         bool populated;
 
+        /// The part of populate() used when our source produces batches.
+        void populateFromBatches();
+
+        /*
+          Adds documents [begin, end) to the group for id.  inputs[i] holds
+          the values of vpExpression[i], indexed by document.
+         */
+        void processInputs(Value id, const vector<const vector<Value>*>& inputs,
+                           size_t begin, size_t end);
+
+        /*
+          Evaluates pExpression for every document in a batch.  Field paths
+          read the batch's columns, and a plain top-level field returns its
+          column as is; anything else is evaluated one document at a time,
+          using documents materialized into pDocuments on first need.  The
+          result is either a column of the batch or pScratch.
+         */
+        static const vector<Value>& evaluateBatch(const intrusive_ptr<Expression>& pExpression,
+                                                  const DocumentBatch& batch,
+                                                  vector<Document>* pDocuments,
+                                                  vector<Value>* pScratch);
+
         intrusive_ptr<Expression> pIdExpression;
 
-        typedef vector<intrusive_ptr<Accumulator> > Accumulators;
-        typedef boost::unordered_map<Value, Accumulators, Value::Hash> GroupsMap;
-        GroupsMap groups;
+        vector<Partition> _partitions;
 
         /*
           The field names for the result documents and the accumulator
@@ -640,14 +806,25 @@ namespace mongo {
         Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
         bool _doingMerge;
-        bool _spilled;
         const bool _extSortAllowed;
         const int _maxMemoryUsageBytes;
+        long long _memoryUsageBytes;
+
+        // stats, reported by explain
+        long long _peakMemoryUsageBytes;
+        long long _bytesSpilled;
+        long long _spills;
+        long long _partitionsSpilled;
+        long long _partitionsMergedSorted;
 
-        // only used when !_spilled
+        // partitions in the order we return them: in memory ones first, then spilled ones
+        vector<size_t> _outputOrder;
+        size_t _outputPosition;
+
+        // iterates the groups of the current partition unless it is being merged by _sorterIterator
         GroupsMap::iterator groupsIterator;
 
-        // only used when _spilled
+        // only used for a spilled partition too big to re-aggregate in memory
         scoped_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
         pair<Value, Value> _firstPartOfNextGroup;
         Value _currentId;
@@ -720,6 +897,18 @@ namespace mongo {
             const CursorIds& cursorIds,
             const intrusive_ptr<ExpressionContext> &pExpCtx);
 
+        /**
+         * Opens the cursors and waits for their first batches.  Used when the shards' outputs
+         * are merged rather than interleaved; the cursors stay owned by this source.
+         */
+        vector<DBClientCursor*> getCursors();
+
+        /**
+         * Returns the next Document from one of the shard cursors, uasserting if the shard sent
+         * back an error instead.
+         */
+        Document nextSafeFrom(DBClientCursor* cursor);
+
         static const char name[];
     protected:
         // virtuals from DocumentSource
@@ -740,6 +929,8 @@ namespace mongo {
             const CursorIds& cursorIds,
             const intrusive_ptr<ExpressionContext> &pExpCtx);
 
+        void start();
+
         // This is the description of cursors to merge.
         const CursorIds _cursorIds;
 
@@ -859,11 +1050,10 @@ namespace mongo {
         virtual GetDepsReturn getDependencies(set<string>& deps) const;
 
         // Virtuals for SplittableDocumentSource
-        // All work for sort is done in router currently if there is no limit.
-        // If there is a limit, the $sort/$limit combination is performed on the
-        // shards, then the results are resorted and limited on mongos
-        virtual intrusive_ptr<DocumentSource> getShardSource() { return limitSrc ? this : NULL; }
-        virtual intrusive_ptr<DocumentSource> getRouterSource() { return this; }
+        // The $sort (and any $limit) is performed on the shards, then mongos
+        // streams the results out of a merge of the already sorted shard outputs
+        virtual intrusive_ptr<DocumentSource> getShardSource();
+        virtual intrusive_ptr<DocumentSource> getRouterSource();
 
         /**
           Add sort key field.
@@ -911,6 +1101,9 @@ namespace mongo {
 
         intrusive_ptr<DocumentSourceLimit> getLimitSrc() const { return limitSrc; }
 
+        /// true if this only merges the presorted outputs of the shards
+        bool isMergingPresorted() const { return _mergingPresorted; }
+
         static const char sortName[];
     protected:
         // virtuals from DocumentSource
@@ -930,6 +1123,16 @@ namespace mongo {
         void populate();
         bool populated;
 
+        /*
+          Instead of sorting, do a k-way merge of the shards' outputs, each
+          of which is already sorted.  Only used when reading straight from
+          a $mergeCursors or the DocumentSourceCommandShards used for mongods
+          without cursors.
+         */
+        void populateFromCursors(const vector<DBClientCursor*>& cursors);
+        void populateFromBsonArrays(const vector<BSONArray>& arrays);
+        bool _mergingPresorted;
+
         /* these two parallel each other */
         typedef vector<intrusive_ptr<ExpressionFieldPath> > SortPaths;
         SortPaths vSortKey;
@@ -954,6 +1157,12 @@ namespace mongo {
             const DocumentSourceSort& _source;
         };
 
+        SortOptions makeSortOptions() const;
+
+        // Feed the merge one document at a time from each shard
+        class IteratorFromCursor;
+        class IteratorFromBsonArray;
+
         intrusive_ptr<DocumentSourceLimit> limitSrc;
 
         bool _done;
@@ -54,6 +54,34 @@ namespace mongo {
         return pSource;
     }
 
+    BSONArray DocumentSourceCommandShards::checkResult(
+            const Strategy::CommandResult& shardResult) {
+        BSONObj resultObj = shardResult.result;
+
+        uassert(16390, str::stream() << "sharded pipeline failed on shard " <<
+                                    shardResult.shardTarget.getName() << ": " <<
+                                    resultObj.toString(),
+                resultObj["ok"].trueValue());
+
+        /* grab the result array out of the shard server's response */
+        BSONElement resultArray = resultObj["result"];
+        massert(16391, str::stream() << "no result array? shard:" <<
+                                    shardResult.shardTarget.getName() << ": " <<
+                                    resultObj.toString(),
+                resultArray.type() == Array);
+
+        return BSONArray(resultArray.embeddedObject());
+    }
+
+    vector<BSONArray> DocumentSourceCommandShards::getArrays() {
+        vector<BSONArray> out;
+        for (; iterator != listEnd; ++iterator) {
+            out.push_back(checkResult(*iterator));
+        }
+
+        return out;
+    }
+
     boost::optional<Document> DocumentSourceCommandShards::getNext() {
         pExpCtx->checkForInterrupt();
 
@@ -63,20 +91,9 @@ namespace mongo {
                 if (iterator == listEnd)
                     return boost::none;
 
-                /* grab the next command result */
-                BSONObj resultObj = iterator->result;
-
-                uassert(16390, str::stream() << "sharded pipeline failed on shard " <<
-                                            iterator->shardTarget.getName() << ": " <<
-                                            resultObj.toString(),
-                        resultObj["ok"].trueValue());
-
-                /* grab the result array out of the shard server's response */
-                BSONElement resultArray = resultObj["result"];
-                massert(16391, str::stream() << "no result array? shard:" <<
-                                            iterator->shardTarget.getName() << ": " <<
-                                            resultObj.toString(),
-                        resultArray.type() == Array);
+                /* grab the result array out of the next command result */
+                checkResult(*iterator);
+                BSONElement resultArray = iterator->result["result"];
 
                 // done with error checking, don't need the shard name anymore
                 ++iterator;
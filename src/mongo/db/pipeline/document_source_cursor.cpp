@@ -46,6 +46,51 @@ namespace mongo {
         return out;
     }
 
+    bool DocumentSourceCursor::producesBatches() const {
+        // Without the dependencies we wouldn't know which columns to make. A dependency on the
+        // whole document shows up as an empty field name, and needs the original field order.
+        if (!_projection || _columnNames.empty())
+            return false;
+
+        for (size_t i = 0; i < _columnNames.size(); i++) {
+            if (_columnNames[i].empty())
+                return false;
+        }
+        return true;
+    }
+
+    bool DocumentSourceCursor::getNextBatch(DocumentBatch* pBatch) {
+        pExpCtx->checkForInterrupt();
+
+        dassert(producesBatches());
+        dassert(_currentBatch.empty()); // getNext() and getNextBatch() can't be mixed
+
+        pBatch->reset(_columnNames);
+        loadBatch(pBatch);
+        return !pBatch->empty();
+    }
+
+    void DocumentSourceCursor::appendToColumns(DocumentBatch* pColumns, const BSONObj& obj) const {
+        const size_t document = pColumns->addDocument();
+
+        BSONObjIterator it(obj);
+        while (it.more()) {
+            BSONElement bsonElement(it.next());
+            StringData fieldName(bsonElement.fieldName(), bsonElement.fieldNameSize()-1);
+
+            const int column = pColumns->findColumn(fieldName);
+            if (column < 0)
+                continue;
+
+            // like documentFromBsonWithDeps(), the first of any duplicate fields wins
+            if (!pColumns->getColumn(column)[document].missing())
+                continue;
+
+            pColumns->setField(document, column,
+                               valueFromBsonWithDeps(bsonElement, _dependencies[fieldName]));
+        }
+    }
+
     void DocumentSourceCursor::dispose() {
         if (_cursorId) {
             ClientCursor::erase(_cursorId);
@@ -81,7 +126,7 @@ namespace mongo {
         }
     }
 
-    void DocumentSourceCursor::loadBatch() {
+    void DocumentSourceCursor::loadBatch(DocumentBatch* pColumns) {
         if (!_cursorId) {
             dispose();
             return;
@@ -116,7 +161,15 @@ namespace mongo {
             if (canUseCoveredIndex(cursor)) {
                 // Can't have collection metadata if we are here
                 BSONObj indexKey = cursor->currKey();
-                _currentBatch.push_back(Document(cursor->c()->keyFieldsOnly()->hydrate(indexKey)));
+                BSONObj next = cursor->c()->keyFieldsOnly()->hydrate(indexKey);
+                if (pColumns) {
+                    appendToColumns(pColumns, next);
+                    memUsageBytes += next.objsize();
+                }
+                else {
+                    _currentBatch.push_back(Document(next));
+                    memUsageBytes += _currentBatch.back().getApproximateSize();
+                }
             }
             else {
                 BSONObj next = cursor->current();
@@ -128,9 +181,18 @@ namespace mongo {
                     if ( !_collMetadata->keyBelongsToMe( kp.extractSingleKey( next ) ) ) continue;
                 }
 
-                _currentBatch.push_back(_projection
-                                            ? documentFromBsonWithDeps(next, _dependencies)
-                                            : Document(next));
+                if (pColumns) {
+                    appendToColumns(pColumns, next);
+                    memUsageBytes += next.objsize();
+                }
+                else {
+                    // Without the dependencies we don't know what will be read, so only
+                    // convert the fields that are.
+                    _currentBatch.push_back(_projection
+                                                ? documentFromBsonWithDeps(next, _dependencies)
+                                                : Document::lazyFromBson(next));
+                    memUsageBytes += _currentBatch.back().getApproximateSize();
+                }
             }
 
             if (_limit) {
@@ -140,8 +202,6 @@ namespace mongo {
                 verify(_docsAddedToBatches < _limit->getLimit());
             }
 
-            memUsageBytes += _currentBatch.back().getApproximateSize();
-
             if (memUsageBytes > MaxBytesToReturnToClientAtOnce) {
                 // End this batch and prepare cursor for yielding.
                 cursor->advance();
@@ -260,5 +320,10 @@ namespace mongo {
         pin.c()->fields = _projection;
 
         _dependencies = deps;
+
+        _columnNames.clear();
+        for (FieldIterator it(_dependencies); it.more(); ) {
+            _columnNames.push_back(it.next().first.toString());
+        }
     }
 }
@@ -38,77 +38,96 @@ namespace mongo {
         if (!populated)
             populate();
 
-        if (_spilled) {
-            if (!_sorterIterator)
-                return boost::none;
-
-            const size_t numAccumulators = vpAccumulatorFactory.size();
-            for (size_t i=0; i < numAccumulators; i++) {
-                _currentAccumulators[i]->reset(); // prep accumulators for a new group
+        while (_outputPosition < _outputOrder.size()) {
+            if (_sorterIterator)
+                return getNextSorted();
+
+            Partition& partition = _partitions[_outputOrder[_outputPosition]];
+            if (groupsIterator != partition.groups.end()) {
+                Document out = makeDocument(groupsIterator->first,
+                                            groupsIterator->second,
+                                            pExpCtx->inShard);
+                ++groupsIterator;
+                return out;
             }
 
-            _currentId = _firstPartOfNextGroup.first;
-            while (_currentId == _firstPartOfNextGroup.first) {
-                // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
-                // At loop exit, it is the first value to be processed in the next group.
+            // done with this partition, free it before loading the next one
+            _memoryUsageBytes -= partition.memoryUsageBytes;
+            partition.memoryUsageBytes = 0;
+            GroupsMap().swap(partition.groups);
 
-                switch (numAccumulators) { // mirrors switch in spill()
-                case 0: // no Accumulators so no Values
-                    break;
+            if (++_outputPosition < _outputOrder.size())
+                startPartition();
+        }
 
-                case 1: // single accumulators serialize as a single Value
-                    _currentAccumulators[0]->process(_firstPartOfNextGroup.second,
-                                                     /*merging=*/true);
-                    break;
+        dispose();
+        return boost::none;
+    }
 
-                default: { // multiple accumulators serialize as an array
-                    const vector<Value>& accumulatorStates =
-                        _firstPartOfNextGroup.second.getArray();
-                    for (size_t i=0; i < numAccumulators; i++) {
-                        _currentAccumulators[i]->process(accumulatorStates[i],
-                                                         /*merging=*/true);
-                    }
-                    break;
-                }
-                }
+    Document DocumentSourceGroup::getNextSorted() {
+        const size_t numAccumulators = vpAccumulatorFactory.size();
+        for (size_t i=0; i < numAccumulators; i++) {
+            _currentAccumulators[i]->reset(); // prep accumulators for a new group
+        }
 
-                if (!_sorterIterator->more()) {
-                    dispose();
-                    break;
+        _currentId = _firstPartOfNextGroup.first;
+        while (_currentId == _firstPartOfNextGroup.first) {
+            // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
+            // At loop exit, it is the first value to be processed in the next group.
+
+            switch (numAccumulators) { // mirrors switch in spill()
+            case 0: // no Accumulators so no Values
+                break;
+
+            case 1: // single accumulators serialize as a single Value
+                _currentAccumulators[0]->process(_firstPartOfNextGroup.second,
+                                                 /*merging=*/true);
+                break;
+
+            default: { // multiple accumulators serialize as an array
+                const vector<Value>& accumulatorStates =
+                    _firstPartOfNextGroup.second.getArray();
+                for (size_t i=0; i < numAccumulators; i++) {
+                    _currentAccumulators[i]->process(accumulatorStates[i],
+                                                     /*merging=*/true);
                 }
-
-                _firstPartOfNextGroup = _sorterIterator->next();
+                break;
+            }
             }
 
-            return makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
-
-        } else {
-            if (groups.empty())
-                return boost::none;
-
-            Document out = makeDocument(groupsIterator->first,
-                                        groupsIterator->second,
-                                        pExpCtx->inShard);
-
-            if (++groupsIterator == groups.end())
-                dispose();
+            if (!_sorterIterator->more()) {
+                // getNext() moves on to the next partition
+                _sorterIterator.reset();
+                break;
+            }
 
-            return out;
+            _firstPartOfNextGroup = _sorterIterator->next();
         }
+
+        return makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
     }
 
     void DocumentSourceGroup::dispose() {
         // free our resources
-        GroupsMap().swap(groups);
+        vector<Partition>().swap(_partitions);
         _sorterIterator.reset();
+        _memoryUsageBytes = 0;
 
         // make us look done
-        groupsIterator = groups.end();
+        _outputPosition = _outputOrder.size();
 
         // free our source's resources
         pSource->dispose();
     }
 
+    void DocumentSourceGroup::optimize() {
+        pIdExpression = pIdExpression->optimize();
+
+        for (size_t i = 0; i < vpExpression.size(); i++) {
+            vpExpression[i] = vpExpression[i]->optimize();
+        }
+    }
+
     void DocumentSourceGroup::sourceToBson(BSONObjBuilder* pBuilder, bool explain) const {
         MutableDocument insides;
 
@@ -130,6 +149,20 @@ namespace mongo {
             insides["$doingMerge"] = Value(true);
         }
 
+        if (explain) {
+            MutableDocument stats;
+            stats["maxMemoryUsageBytes"] = Value(_maxMemoryUsageBytes);
+            stats["partitions"] = Value(static_cast<int>(numPartitions));
+            if (populated) {
+                stats["peakMemoryUsageBytes"] = Value(_peakMemoryUsageBytes);
+                stats["spills"] = Value(_spills);
+                stats["bytesSpilled"] = Value(_bytesSpilled);
+                stats["partitionsSpilled"] = Value(_partitionsSpilled);
+                stats["partitionsMergedSorted"] = Value(_partitionsMergedSorted);
+            }
+            insides["$stats"] = stats.freezeToValue();
+        }
+
         *pBuilder << groupName << insides.freeze();
     }
 
@@ -157,9 +190,15 @@ namespace mongo {
         : SplittableDocumentSource(pExpCtx)
         , populated(false)
         , _doingMerge(false)
-        , _spilled(false)
         , _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter)
         , _maxMemoryUsageBytes(100*1024*1024)
+        , _memoryUsageBytes(0)
+        , _peakMemoryUsageBytes(0)
+        , _bytesSpilled(0)
+        , _spills(0)
+        , _partitionsSpilled(0)
+        , _partitionsMergedSorted(0)
+        , _outputPosition(0)
     {}
 
     void DocumentSourceGroup::addAccumulator(
@@ -171,6 +210,16 @@ namespace mongo {
         vpExpression.push_back(pExpression);
     }
 
+    bool DocumentSourceGroup::dependsOnInputOrder() const {
+        for (size_t i = 0; i < vpAccumulatorFactory.size(); i++) {
+            if (vpAccumulatorFactory[i] == AccumulatorFirst::create
+                    || vpAccumulatorFactory[i] == AccumulatorLast::create
+                    || vpAccumulatorFactory[i] == AccumulatorPush::create)
+                return true;
+        }
+        return false;
+    }
+
 
     struct GroupOpDesc {
         const char* name;
@@ -332,102 +381,342 @@ namespace mongo {
         };
     }
 
+    DocumentSourceGroup::Partition::Partition()
+        : memoryUsageBytes(0)
+        , spilledBytes(0)
+    {}
+
+    size_t DocumentSourceGroup::partitionFor(const Value& id) {
+        // Mix the hash so that partitioning doesn't line up with the buckets of the
+        // unordered_maps, which also hash on the _id.
+        const unsigned h = static_cast<unsigned>(Value::Hash()(id)) * 0x9E3779B1U;
+        return (h >> 16) % numPartitions;
+    }
+
     void DocumentSourceGroup::populate() {
         const size_t numAccumulators = vpAccumulatorFactory.size();
         dassert(numAccumulators == vpExpression.size());
 
-        // pushed to on spill()
-        vector<shared_ptr<Sorter<Value, Value>::Iterator> > sortedFiles;
-        int memoryUsageBytes = 0;
-
-        // This loop consumes all input from pSource and buckets it based on pIdExpression.
-        while (boost::optional<Document> input = pSource->getNext()) {
-            if (memoryUsageBytes > _maxMemoryUsageBytes) {
-                uassert(16945, "Exceeded memory limit for $group, but didn't allow external sort",
-                        _extSortAllowed);
-                sortedFiles.push_back(spill());
-                memoryUsageBytes = 0;
+        _partitions.resize(numPartitions);
+
+        if (pSource->producesBatches()) {
+            populateFromBatches();
+        }
+        else {
+            // Each input is processed as a batch of one document.
+            vector<vector<Value> > values(numAccumulators, vector<Value>(1));
+            vector<const vector<Value>*> inputs(numAccumulators);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                inputs[i] = &values[i];
             }
 
-            const Variables vars(*input);
+            // This loop consumes all input from pSource and buckets it based on pIdExpression.
+            while (boost::optional<Document> input = pSource->getNext()) {
+                const Variables vars(*input);
 
-            /* get the _id value */
-            Value id = pIdExpression->evaluate(vars);
+                /* get the _id value */
+                const Value id = pIdExpression->evaluate(vars);
 
-            /* treat missing values the same as NULL SERVER-4674 */
-            if (id.missing())
-                id = Value(BSONNULL);
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    values[i][0] = vpExpression[i]->evaluate(vars);
+                }
 
-            /*
-              Look for the _id value in the map; if it's not there, add a
-              new entry with a blank accumulator.
-            */
-            const size_t oldSize = groups.size();
-            vector<intrusive_ptr<Accumulator> >& group = groups[id];
-            const bool inserted = groups.size() != oldSize;
+                processInputs(id, inputs, 0, 1);
+            }
+        }
 
-            if (inserted) {
-                memoryUsageBytes += id.getApproximateSize();
+        // Return the partitions that are still entirely in memory first. Their memory is freed as
+        // we go, which leaves room to re-aggregate the spilled partitions afterwards.
+        _outputOrder.clear();
+        for (size_t i = 0; i < numPartitions; i++) {
+            if (_partitions[i].spills.empty())
+                _outputOrder.push_back(i);
+        }
+        for (size_t i = 0; i < numPartitions; i++) {
+            if (!_partitions[i].spills.empty())
+                _outputOrder.push_back(i);
+        }
 
-                // Add the accumulators
-                group.reserve(numAccumulators);
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    group.push_back(vpAccumulatorFactory[i]());
+        if (_spills) {
+            LOG(1) << "$group spilled " << _partitionsSpilled << " of " << numPartitions
+                   << " partitions in " << _spills << " runs, " << _bytesSpilled << " bytes" << endl;
+        }
+
+        _outputPosition = 0;
+        startPartition();
+
+        populated = true;
+    }
+
+    void DocumentSourceGroup::populateFromBatches() {
+        const size_t numAccumulators = vpExpression.size();
+
+        DocumentBatch batch;
+        vector<Document> documents;
+        vector<Value> idScratch;
+        vector<vector<Value> > inputScratch(numAccumulators);
+        vector<const vector<Value>*> inputs(numAccumulators);
+
+        while (pSource->getNextBatch(&batch)) {
+            documents.clear();
+
+            const vector<Value>& ids = evaluateBatch(pIdExpression, batch, &documents, &idScratch);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                inputs[i] = &evaluateBatch(vpExpression[i], batch, &documents, &inputScratch[i]);
+            }
+
+            // Consecutive documents with the same _id only need one lookup of their group.
+            const size_t n = batch.size();
+            for (size_t begin = 0, end = 0; begin < n; begin = end) {
+                for (end = begin + 1; end < n; end++) {
+                    if (Value::compare(ids[begin], ids[end]) != 0)
+                        break;
                 }
-            } else {
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    // subtract old mem usage. New usage added back after processing.
-                    memoryUsageBytes -= group[i]->memUsageForSorter();
+
+                processInputs(ids[begin], inputs, begin, end);
+            }
+        }
+    }
+
+    const vector<Value>& DocumentSourceGroup::evaluateBatch(
+            const intrusive_ptr<Expression>& pExpression,
+            const DocumentBatch& batch,
+            vector<Document>* pDocuments,
+            vector<Value>* pScratch) {
+        const size_t n = batch.size();
+
+        if (const ExpressionConstant* pConstant =
+                dynamic_cast<const ExpressionConstant*>(pExpression.get())) {
+            pScratch->assign(n, pConstant->getValue());
+            return *pScratch;
+        }
+
+        if (const ExpressionFieldPath* pFieldPath =
+                dynamic_cast<const ExpressionFieldPath*>(pExpression.get())) {
+            if (pFieldPath->isPathInDocument()) {
+                const int column = batch.findColumn(pFieldPath->getFieldPath().getFieldName(1));
+                if (column >= 0) {
+                    const vector<Value>& values = batch.getColumn(column);
+                    if (pFieldPath->getFieldPath().getPathLength() == 2)
+                        return values;
+
+                    pScratch->resize(n);
+                    for (size_t i = 0; i < n; i++) {
+                        (*pScratch)[i] = pFieldPath->evaluateFromField(values[i]);
+                    }
+                    return *pScratch;
                 }
             }
+        }
 
-            /* tickle all the accumulators for the group we found */
-            dassert(numAccumulators == group.size());
+        if (pDocuments->empty()) {
+            pDocuments->reserve(n);
+            for (size_t i = 0; i < n; i++) {
+                pDocuments->push_back(batch.getDocument(i));
+            }
+        }
+
+        pScratch->resize(n);
+        for (size_t i = 0; i < n; i++) {
+            (*pScratch)[i] = pExpression->evaluate(Variables((*pDocuments)[i]));
+        }
+        return *pScratch;
+    }
+
+    void DocumentSourceGroup::processInputs(Value id,
+                                            const vector<const vector<Value>*>& inputs,
+                                            size_t begin,
+                                            size_t end) {
+        const size_t numAccumulators = vpAccumulatorFactory.size();
+        dassert(numAccumulators == inputs.size());
+
+        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+            uassert(16945, "Exceeded memory limit for $group, but didn't allow external sort",
+                    _extSortAllowed);
+            spillLargestPartitions();
+        }
+
+        /* treat missing values the same as NULL SERVER-4674 */
+        if (id.missing())
+            id = Value(BSONNULL);
+
+        /*
+          Look for the _id value in its partition's map; if it's not
+          there, add a new entry with a blank accumulator.
+        */
+        Partition& partition = _partitions[partitionFor(id)];
+        const size_t oldSize = partition.groups.size();
+        vector<intrusive_ptr<Accumulator> >& group = partition.groups[id];
+        const bool inserted = partition.groups.size() != oldSize;
+
+        long long memoryDelta = 0;
+        if (inserted) {
+            memoryDelta += id.getApproximateSize();
+
+            // Add the accumulators
+            group.reserve(numAccumulators);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                group.push_back(vpAccumulatorFactory[i]());
+            }
+        } else {
             for (size_t i = 0; i < numAccumulators; i++) {
-                group[i]->process(vpExpression[i]->evaluate(vars), _doingMerge);
-                memoryUsageBytes += group[i]->memUsageForSorter();
+                // subtract old mem usage. New usage added back after processing.
+                memoryDelta -= group[i]->memUsageForSorter();
             }
+        }
 
-            DEV {
-                // In debug mode, spill every time we have a duplicate id to stress merge logic.
-                if (!inserted // is a dup
-                        && !pExpCtx->inRouter // can't spill to disk in router
-                        && !_extSortAllowed // don't change behavior when testing external sort
-                        && sortedFiles.size() < 20 // don't open too many FDs
-                        ) {
-                    sortedFiles.push_back(spill());
-                }
+        /* tickle all the accumulators for the group we found */
+        dassert(numAccumulators == group.size());
+        for (size_t i = 0; i < numAccumulators; i++) {
+            group[i]->processBatch(&(*inputs[i])[begin], end - begin, _doingMerge);
+            memoryDelta += group[i]->memUsageForSorter();
+        }
+
+        partition.memoryUsageBytes += memoryDelta;
+        _memoryUsageBytes += memoryDelta;
+        _peakMemoryUsageBytes = std::max(_peakMemoryUsageBytes, _memoryUsageBytes);
+
+        DEV {
+            // In debug mode, spill every time we have a duplicate id to stress merge logic.
+            if (!inserted // is a dup
+                    && !pExpCtx->inRouter // can't spill to disk in router
+                    && !_extSortAllowed // don't change behavior when testing external sort
+                    && _spills < 20 // don't open too many FDs
+                    ) {
+                spill(partition);
             }
         }
+    }
 
-        // These blocks do any final steps necessary to prepare to output results.
-        if (!sortedFiles.empty()) {
-            _spilled = true;
-            if (!groups.empty()) {
-                sortedFiles.push_back(spill());
+    void DocumentSourceGroup::spillLargestPartitions() {
+        while (_memoryUsageBytes > _maxMemoryUsageBytes / 2) {
+            Partition* largest = NULL;
+            for (size_t i = 0; i < numPartitions; i++) {
+                if (!largest || _partitions[i].memoryUsageBytes > largest->memoryUsageBytes)
+                    largest = &_partitions[i];
             }
 
-            // We won't be using groups again so free its memory.
-            GroupsMap().swap(groups);
+            if (largest->groups.empty())
+                return; // nothing left to free
+
+            spill(*largest);
+        }
+    }
 
+    void DocumentSourceGroup::startPartition() {
+        Partition& partition = _partitions[_outputOrder[_outputPosition]];
+        groupsIterator = partition.groups.begin();
+
+        if (partition.spills.empty())
+            return;
+
+        const size_t numAccumulators = vpAccumulatorFactory.size();
+
+        if (_memoryUsageBytes + partition.spilledBytes > _maxMemoryUsageBytes) {
+            // Too big to re-aggregate in memory. Every run is sorted, so merge them instead.
+            if (!partition.groups.empty())
+                spill(partition);
+
+            _partitionsMergedSorted++;
             _sorterIterator.reset(
                     Sorter<Value,Value>::Iterator::merge(
-                        sortedFiles, SortOptions(), SorterComparator()));
+                        partition.spills, SortOptions(), SorterComparator()));
+            partition.spills.clear();
+            groupsIterator = partition.groups.end();
 
             // prepare current to accumulate data
-            _currentAccumulators.reserve(numAccumulators);
-            for (size_t i = 0; i < numAccumulators; i++) {
-                _currentAccumulators.push_back(vpAccumulatorFactory[i]());
+            if (_currentAccumulators.empty()) {
+                _currentAccumulators.reserve(numAccumulators);
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    _currentAccumulators.push_back(vpAccumulatorFactory[i]());
+                }
             }
 
             verify(_sorterIterator->more()); // we put data in, we should get something out.
             _firstPartOfNextGroup = _sorterIterator->next();
-        } else {
-            // start the group iterator
-            groupsIterator = groups.begin();
+            return;
         }
 
-        populated = true;
+        // Read the runs back in the order they were written, then fold in the groups still in
+        // memory, which hold the newest documents.  Order sensitive accumulators like $first,
+        // $last and $push see their input in the same order as if nothing had spilled.
+        const long long memoryUsageBefore = partition.memoryUsageBytes;
+        GroupsMap remainder;
+        remainder.swap(partition.groups);
+        partition.memoryUsageBytes = 0;
+
+        for (size_t run = 0; run < partition.spills.size(); run++) {
+            Sorter<Value, Value>::Iterator& it = *partition.spills[run];
+            while (it.more()) {
+                pExpCtx->checkForInterrupt();
+
+                const pair<Value, Value> data = it.next();
+
+                const size_t oldSize = partition.groups.size();
+                Accumulators& group = partition.groups[data.first];
+                if (partition.groups.size() != oldSize) {
+                    partition.memoryUsageBytes += data.first.getApproximateSize();
+                    group.reserve(numAccumulators);
+                    for (size_t i = 0; i < numAccumulators; i++) {
+                        group.push_back(vpAccumulatorFactory[i]());
+                    }
+                }
+                else {
+                    for (size_t i = 0; i < numAccumulators; i++) {
+                        partition.memoryUsageBytes -= group[i]->memUsageForSorter();
+                    }
+                }
+
+                switch (numAccumulators) { // mirrors switch in spill()
+                case 0:
+                    break;
+
+                case 1:
+                    group[0]->process(data.second, /*merging=*/true);
+                    break;
+
+                default: {
+                    const vector<Value>& accumulatorStates = data.second.getArray();
+                    for (size_t i = 0; i < numAccumulators; i++) {
+                        group[i]->process(accumulatorStates[i], /*merging=*/true);
+                    }
+                    break;
+                }
+                }
+
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    partition.memoryUsageBytes += group[i]->memUsageForSorter();
+                }
+            }
+        }
+
+        for (GroupsMap::iterator it = remainder.begin(); it != remainder.end(); ++it) {
+            const size_t oldSize = partition.groups.size();
+            Accumulators& group = partition.groups[it->first];
+            if (partition.groups.size() != oldSize) {
+                // not in any run, take the accumulators as they are
+                group.swap(it->second);
+                partition.memoryUsageBytes += it->first.getApproximateSize();
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    partition.memoryUsageBytes += group[i]->memUsageForSorter();
+                }
+                continue;
+            }
+
+            for (size_t i = 0; i < numAccumulators; i++) {
+                partition.memoryUsageBytes -= group[i]->memUsageForSorter();
+                group[i]->process(it->second[i]->getValue(/*toBeMerged=*/true),
+                                  /*merging=*/true);
+                partition.memoryUsageBytes += group[i]->memUsageForSorter();
+            }
+        }
+        GroupsMap().swap(remainder);
+
+        partition.spills.clear(); // deletes the files
+        _memoryUsageBytes += partition.memoryUsageBytes - memoryUsageBefore;
+        _peakMemoryUsageBytes = std::max(_peakMemoryUsageBytes, _memoryUsageBytes);
+        partition.spilledBytes = 0;
+        groupsIterator = partition.groups.begin();
     }
 
     class DocumentSourceGroup::SpillSTLComparator {
@@ -437,7 +726,9 @@ namespace mongo {
         }
     };
 
-    shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
+    void DocumentSourceGroup::spill(Partition& partition) {
+        GroupsMap& groups = partition.groups;
+
         vector<const GroupsMap::value_type*> ptrs; // using pointers to speed sorting
         ptrs.reserve(groups.size());
         for (GroupsMap::const_iterator it=groups.begin(), end=groups.end(); it != end; ++it) {
@@ -472,9 +763,17 @@ namespace mongo {
             break;
         }
 
-        groups.clear();
+        GroupsMap().swap(groups);
+
+        if (partition.spills.empty())
+            _partitionsSpilled++;
+        _spills++;
+        _bytesSpilled += partition.memoryUsageBytes;
 
-        return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+        partition.spills.push_back(shared_ptr<Sorter<Value, Value>::Iterator>(writer.done()));
+        partition.spilledBytes += partition.memoryUsageBytes;
+        _memoryUsageBytes -= partition.memoryUsageBytes;
+        partition.memoryUsageBytes = 0;
     }
 
     Document DocumentSourceGroup::makeDocument(const Value& id,
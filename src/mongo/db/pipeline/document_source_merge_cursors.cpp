@@ -83,33 +83,58 @@ namespace mongo {
         , cursor(connection.get(), ns, id, 0, 0)
     {}
 
-    boost::optional<Document> DocumentSourceMergeCursors::getNext() {
-        if (_unstarted) {
-            _unstarted = false;
-
-            // open each cursor and send message asking for a batch
-            for (CursorIds::const_iterator it = _cursorIds.begin(); it !=_cursorIds.end(); ++it) {
-                _cursors.push_back(boost::make_shared<CursorAndConnection>(
-                            it->first, pExpCtx->ns, it->second));
-                verify(_cursors.back()->connection->lazySupported());
-                _cursors.back()->cursor.initLazy(); // shouldn't block
-            }
-
-            // wait for all cursors to return a batch
-            // TODO need a way to keep cursors alive if some take longer than 10 minutes.
-            for (Cursors::const_iterator it = _cursors.begin(); it !=_cursors.end(); ++it) {
-                bool retry = false;
-                bool ok = (*it)->cursor.initLazyFinish(retry); // blocks here for first batch
-
-                uassert(17028,
-                        "error reading response from " + _cursors.back()->connection->toString(),
-                        ok);
-                verify(!retry);
-            }
+    void DocumentSourceMergeCursors::start() {
+        _unstarted = false;
+
+        // open each cursor and send message asking for a batch
+        for (CursorIds::const_iterator it = _cursorIds.begin(); it !=_cursorIds.end(); ++it) {
+            _cursors.push_back(boost::make_shared<CursorAndConnection>(
+                        it->first, pExpCtx->ns, it->second));
+            verify(_cursors.back()->connection->lazySupported());
+            _cursors.back()->cursor.initLazy(); // shouldn't block
+        }
 
-            _currentCursor = _cursors.begin();
+        // wait for all cursors to return a batch
+        // TODO need a way to keep cursors alive if some take longer than 10 minutes.
+        for (Cursors::const_iterator it = _cursors.begin(); it !=_cursors.end(); ++it) {
+            bool retry = false;
+            bool ok = (*it)->cursor.initLazyFinish(retry); // blocks here for first batch
+
+            uassert(17028,
+                    "error reading response from " + _cursors.back()->connection->toString(),
+                    ok);
+            verify(!retry);
+        }
+
+        _currentCursor = _cursors.begin();
+    }
+
+    vector<DBClientCursor*> DocumentSourceMergeCursors::getCursors() {
+        verify(_unstarted);
+        start();
+        vector<DBClientCursor*> out;
+        for (Cursors::const_iterator it = _cursors.begin(); it !=_cursors.end(); ++it) {
+            out.push_back(&((*it)->cursor));
         }
 
+        return out;
+    }
+
+    Document DocumentSourceMergeCursors::nextSafeFrom(DBClientCursor* cursor) {
+        const BSONObj next = cursor->next();
+        uassert(17029, str::stream() << "Received error in response from "
+                                     << cursor->originalHost()
+                                     << ": " << next,
+                !next.hasField("$err"));
+
+        // often returned to the client unchanged, which then needs no conversion at all
+        return Document::lazyFromBson(next);
+    }
+
+    boost::optional<Document> DocumentSourceMergeCursors::getNext() {
+        if (_unstarted)
+            start();
+
         // purge eof cursors and release their connections
         while (!_cursors.empty() && !(*_currentCursor)->cursor.more()) {
             (*_currentCursor)->connection.done();
@@ -120,20 +145,22 @@ namespace mongo {
         if (_cursors.empty())
             return boost::none;
 
-        BSONObj next = (*_currentCursor)->cursor.next();
-        uassert(17029, str::stream() << "Received error in response from "
-                                     << (*_currentCursor)->connection->toString()
-                                     << ": " << next,
-                !next.hasField("$err"));
+        const Document next = nextSafeFrom(&((*_currentCursor)->cursor));
 
         // advance _currentCursor, wrapping if needed
         if (++_currentCursor == _cursors.end())
             _currentCursor = _cursors.begin();
 
-        return Document(next);
+        return next;
     }
 
     void DocumentSourceMergeCursors::dispose() {
+        // a $sort merging from getCursors() doesn't release connections as it goes
+        for (Cursors::const_iterator it = _cursors.begin(); it !=_cursors.end(); ++it) {
+            if ((*it)->cursor.isDead() && !(*it)->cursor.moreInCurrentBatch())
+                (*it)->connection.done();
+        }
+
         _cursors.clear();
         _currentCursor = _cursors.end();
     }
@@ -0,0 +1,370 @@
+/**
+ * Copyright (c) 2013 10gen Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mongo/pch.h"
+
+#include <boost/thread/thread.hpp>
+
+#include "mongo/db/client.h"
+#include "mongo/db/interrupt_status.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/queue.h"
+
+namespace mongo {
+
+    namespace {
+        // documents handed to a worker at a time
+        const size_t BatchSize = 256;
+
+        // worker threads of all aggregations together
+        const unsigned MaxTotalWorkers = 64;
+        AtomicUInt32 runningWorkers;
+
+        /**
+         * Workers never see a killOp directly: only the thread running the command can check
+         * for that.  When it is interrupted it aborts the Feed, which stops the workers at their
+         * next batch.
+         */
+        class InterruptStatusWorker : public InterruptStatus {
+        public:
+            virtual void checkForInterrupt() const {}
+            virtual const char *checkForInterruptNoAssert() const { return ""; }
+        } interruptStatusWorker;
+    }
+
+    class DocumentSourceParallel::Feed : boost::noncopyable {
+    public:
+        typedef vector<Document> Batch;
+
+        explicit Feed(size_t maxBatches)
+            : _queue(maxBatches)
+            , _mutex("DocumentSourceParallel::Feed")
+            , _errorCode(0)
+        {}
+
+        /** blocks while the queue is full.  A NULL batch marks the end of input for one worker */
+        void push(const shared_ptr<Batch>& batch) { _queue.push(batch); }
+
+        shared_ptr<Batch> pop() { return _queue.blockingPop(); }
+
+        /** stop handing out input, workers fail at their next batch */
+        void abort() { _aborted.store(1); }
+        bool aborted() const { return _aborted.load(); }
+
+        /** records the first error from a worker and aborts */
+        void fail(int code, const string& errmsg) {
+            {
+                scoped_lock lk(_mutex);
+                if (_errmsg.empty()) {
+                    _errorCode = code;
+                    _errmsg = errmsg;
+                }
+            }
+            abort();
+        }
+
+        void rethrowIfFailed() {
+            scoped_lock lk(_mutex);
+            if (_errmsg.empty())
+                return;
+
+            uasserted(_errorCode ? _errorCode : 17053,
+                      str::stream() << "aggregation worker failed: " << _errmsg);
+        }
+
+    private:
+        BlockingQueue<shared_ptr<Batch> > _queue;
+        AtomicUInt32 _aborted;
+
+        mongo::mutex _mutex; // guards the error
+        int _errorCode;
+        string _errmsg;
+    };
+
+    namespace {
+        /** The initial source of each worker pipeline */
+        class DocumentSourceFeed : public DocumentSource {
+        public:
+            DocumentSourceFeed(const shared_ptr<DocumentSourceParallel::Feed>& feed,
+                               const intrusive_ptr<ExpressionContext>& pExpCtx)
+                : DocumentSource(pExpCtx)
+                , _feed(feed)
+                , _position(0)
+                , _sawEnd(false)
+            {}
+
+            virtual boost::optional<Document> getNext() {
+                while (!_batch || _position == _batch->size()) {
+                    if (_sawEnd)
+                        return boost::none;
+
+                    uassert(17052, "aggregation stopped by another thread", !_feed->aborted());
+
+                    _batch = _feed->pop();
+                    _position = 0;
+                    if (!_batch) {
+                        _sawEnd = true;
+                        return boost::none;
+                    }
+                }
+
+                return (*_batch)[_position++];
+            }
+
+            virtual void setSource(DocumentSource *pSource) {
+                /* this doesn't take a source */
+                verify(false);
+            }
+
+            virtual bool isValidInitialSource() const { return true; }
+
+            virtual void dispose() {
+                _batch.reset();
+            }
+
+            /**
+             * Takes batches until the end of input marker, so the reading thread never blocks
+             * on a queue nobody is emptying.
+             */
+            void drain() {
+                _batch.reset();
+                while (!_sawEnd) {
+                    if (!_feed->pop())
+                        _sawEnd = true;
+                }
+            }
+
+        protected:
+            virtual void sourceToBson(BSONObjBuilder *pBuilder, bool explain) const {
+                // never serialized, it only exists inside DocumentSourceParallel
+                verify(false);
+            }
+
+        private:
+            shared_ptr<DocumentSourceParallel::Feed> _feed;
+            shared_ptr<DocumentSourceParallel::Feed::Batch> _batch;
+            size_t _position;
+            bool _sawEnd;
+        };
+
+        void runWorker(Pipeline* pipeline,
+                       DocumentSourceFeed* input,
+                       DocumentSourceParallel::Feed* feed,
+                       vector<Document>* results) {
+            Client::initThread("aggregation worker");
+
+            try {
+                DocumentSource* output = pipeline->output();
+                while (boost::optional<Document> next = output->getNext()) {
+                    results->push_back(*next);
+                }
+            }
+            catch (const DBException& e) {
+                feed->fail(e.getCode(), e.what());
+            }
+            catch (const std::exception& e) {
+                feed->fail(0, e.what());
+            }
+
+            input->drain();
+
+            cc().shutdown();
+        }
+
+        /** pushes one end of input marker per thread and waits for all of them */
+        void joinWorkers(DocumentSourceParallel::Feed* feed,
+                         const vector<shared_ptr<boost::thread> >& threads) {
+            for (size_t i = 0; i < threads.size(); i++) {
+                feed->push(shared_ptr<DocumentSourceParallel::Feed::Batch>());
+            }
+            for (size_t i = 0; i < threads.size(); i++) {
+                threads[i]->join();
+            }
+        }
+    }
+
+    int DocumentSourceParallel::reserveWorkers(int wanted) {
+        if (wanted < 2)
+            return 0;
+
+        while (true) {
+            const unsigned running = runningWorkers.load();
+            const unsigned granted = std::min(static_cast<unsigned>(wanted),
+                                              MaxTotalWorkers - running);
+            if (granted < 2)
+                return 0;
+
+            if (runningWorkers.compareAndSwap(running, running + granted) == running)
+                return granted;
+        }
+    }
+
+    void DocumentSourceParallel::releaseWorkers(int nWorkers) {
+        runningWorkers.subtractAndFetch(nWorkers);
+    }
+
+    DocumentSourceParallel::~DocumentSourceParallel() {
+        releaseWorkers(_reservedWorkers);
+    }
+
+    boost::optional<Document> DocumentSourceParallel::getNext() {
+        pExpCtx->checkForInterrupt();
+
+        if (!_ran)
+            run();
+
+        while (_currentWorker < _results.size()) {
+            vector<Document>& results = _results[_currentWorker];
+            if (_currentResult < results.size())
+                return results[_currentResult++];
+
+            // free each worker's output once it has been returned
+            vector<Document>().swap(results);
+            _currentWorker++;
+            _currentResult = 0;
+        }
+
+        return boost::none;
+    }
+
+    void DocumentSourceParallel::run() {
+        _ran = true;
+
+        const size_t nWorkers = _workers.size();
+        _results.resize(nWorkers);
+
+        vector<shared_ptr<boost::thread> > threads;
+        try {
+            for (size_t i = 0; i < nWorkers; i++) {
+                DocumentSourceFeed* input =
+                    static_cast<DocumentSourceFeed*>(_workerInputs[i].get());
+                threads.push_back(shared_ptr<boost::thread>(new boost::thread(
+                    boost::bind(&runWorker, _workers[i].get(), input, _feed.get(),
+                                &_results[i]))));
+            }
+
+            shared_ptr<Feed::Batch> batch(new Feed::Batch());
+            batch->reserve(BatchSize);
+            while (!_feed->aborted()) {
+                boost::optional<Document> next = _input->getNext();
+                if (!next)
+                    break;
+
+                batch->push_back(*next);
+                if (batch->size() == BatchSize) {
+                    _feed->push(batch);
+                    batch.reset(new Feed::Batch());
+                    batch->reserve(BatchSize);
+                }
+            }
+
+            if (!batch->empty())
+                _feed->push(batch);
+        }
+        catch (...) {
+            _feed->abort();
+            joinWorkers(_feed.get(), threads);
+            throw;
+        }
+
+        joinWorkers(_feed.get(), threads);
+
+        // release the cursor and its read lock before merging
+        _input->dispose();
+
+        _feed->rethrowIfFailed();
+    }
+
+    void DocumentSourceParallel::dispose() {
+        _input->dispose();
+        _results.clear();
+        _currentWorker = 0;
+        _currentResult = 0;
+    }
+
+    void DocumentSourceParallel::setSource(DocumentSource *pSource) {
+        /* this doesn't take a source */
+        verify(false);
+    }
+
+    void DocumentSourceParallel::sourceToBson(BSONObjBuilder *pBuilder, bool explain) const {
+        /* this has no analog in the BSON world, so only allow it for explain */
+        if (explain) {
+            BSONObjBuilder insides(pBuilder->subobjStart("$parallel"));
+            insides.append("workers", static_cast<int>(_workers.size()));
+            insides.append("pipeline", _shardSpec["pipeline"]);
+            insides.doneFast();
+        }
+    }
+
+    DocumentSourceParallel::DocumentSourceParallel(
+            const intrusive_ptr<DocumentSource>& input,
+            int reservedWorkers,
+            const intrusive_ptr<ExpressionContext>& pExpCtx)
+        : DocumentSource(pExpCtx)
+        , _input(input)
+        , _reservedWorkers(reservedWorkers)
+        , _ran(false)
+        , _currentWorker(0)
+        , _currentResult(0)
+    {}
+
+    intrusive_ptr<DocumentSourceParallel> DocumentSourceParallel::create(
+            const intrusive_ptr<DocumentSource>& input,
+            const intrusive_ptr<Pipeline>& shardPipeline,
+            int nWorkers,
+            const intrusive_ptr<ExpressionContext>& pExpCtx) {
+        verify(nWorkers > 0);
+
+        intrusive_ptr<DocumentSourceParallel> source(
+            new DocumentSourceParallel(input, nWorkers, pExpCtx));
+
+        // Each worker gets its own copy of the shard pipeline by going through BSON, the same way
+        // a shard gets it from mongos.  Nothing a worker evaluates is shared with another thread.
+        BSONObjBuilder shardBuilder;
+        shardPipeline->toBson(&shardBuilder);
+        shardBuilder.append("fromRouter", true); // so the $group output can be merged
+        source->_shardSpec = shardBuilder.obj();
+
+        source->_feed.reset(new Feed(2 * nWorkers));
+
+        for (int i = 0; i < nWorkers; i++) {
+            intrusive_ptr<ExpressionContext> pWorkerCtx =
+                new ExpressionContext(interruptStatusWorker, pExpCtx->ns);
+
+            string errmsg;
+            intrusive_ptr<Pipeline> worker =
+                Pipeline::parseCommand(errmsg, source->_shardSpec, pWorkerCtx);
+            massert(17051, str::stream() << "couldn't copy pipeline for aggregation worker: "
+                                         << errmsg,
+                    worker);
+
+            intrusive_ptr<DocumentSource> workerInput(
+                new DocumentSourceFeed(source->_feed, pWorkerCtx));
+            worker->addInitialSource(workerInput);
+            worker->stitch();
+
+            source->_workers.push_back(worker);
+            source->_workerInputs.push_back(workerInput);
+        }
+
+        return source;
+    }
+}
@@ -51,6 +51,10 @@ namespace mongo {
             sortKeyToBson(&sortKey, false);
             sortKey.doneFast();
 
+            if (_mergingPresorted) {
+                insides.append("mergePresorted", true);
+            }
+
             if (explain && limitSrc) {
                 insides.appendNumber("limit", limitSrc->getLimit());
             }
@@ -62,6 +66,8 @@ namespace mongo {
                 BSONObjBuilder sortObj (pBuilder->subobjStart());
                 BSONObjBuilder insides (sortObj.subobjStart(sortName));
                 sortKeyToBson(&insides, false);
+                if (_mergingPresorted)
+                    insides.append("$mergePresorted", true);
                 insides.doneFast();
                 sortObj.doneFast();
             }
@@ -80,12 +86,28 @@ namespace mongo {
     DocumentSourceSort::DocumentSourceSort(const intrusive_ptr<ExpressionContext> &pExpCtx)
         : SplittableDocumentSource(pExpCtx)
         , populated(false)
+        , _mergingPresorted(false)
     {}
 
     long long DocumentSourceSort::getLimit() const {
         return limitSrc ? limitSrc->getLimit() : -1;
     }
 
+    intrusive_ptr<DocumentSource> DocumentSourceSort::getShardSource() {
+        verify(!_mergingPresorted);
+        return this;
+    }
+
+    intrusive_ptr<DocumentSource> DocumentSourceSort::getRouterSource() {
+        verify(!_mergingPresorted);
+
+        BSONObjBuilder sortKey;
+        sortKeyToBson(&sortKey, false);
+        intrusive_ptr<DocumentSourceSort> merger = create(pExpCtx, sortKey.obj(), getLimit());
+        merger->_mergingPresorted = true;
+        return merger;
+    }
+
     bool DocumentSourceSort::coalesce(const intrusive_ptr<DocumentSource> &pNextSource) {
         if (!limitSrc) {
             limitSrc = dynamic_cast<DocumentSourceLimit*>(pNextSource.get());
@@ -149,6 +171,14 @@ namespace mongo {
             BSONElement keyField(keyIterator.next());
             const char *pKeyFieldName = keyField.fieldName();
             int sortOrder = 0;
+
+            if (str::equals(pKeyFieldName, "$mergePresorted")) {
+                // only generated by mongos for the merging half of a sharded $sort
+                uassert(17058, "$mergePresorted should be true if present",
+                        keyField.type() == Bool && keyField.Bool());
+                pSort->_mergingPresorted = true;
+                continue;
+            }
                 
             uassert(15974, str::stream() << sortName <<
                     " key ordering must be specified using a number",
@@ -175,7 +205,7 @@ namespace mongo {
         return pSort;
     }
 
-    void DocumentSourceSort::populate() {
+    SortOptions DocumentSourceSort::makeSortOptions() const {
         /* make sure we've got a sort key */
         verify(vSortKey.size());
 
@@ -186,16 +216,97 @@ namespace mongo {
         opts.maxMemoryUsageBytes = 100*1024*1024;
         opts.extSortAllowed = pExpCtx->extSortAllowed && !pExpCtx->inRouter;
 
-        scoped_ptr<MySorter> sorter (MySorter::make(opts, Comparator(*this)));
+        return opts;
+    }
+
+    void DocumentSourceSort::populate() {
+        typedef DocumentSourceMergeCursors DSCursors;
+        typedef DocumentSourceCommandShards DSCommands;
+        DSCursors* cursorsSource = NULL;
+        DSCommands* commandsSource = NULL;
+        if (_mergingPresorted) {
+            cursorsSource = dynamic_cast<DSCursors*>(pSource);
+            commandsSource = dynamic_cast<DSCommands*>(pSource);
+        }
 
-        while (boost::optional<Document> next = pSource->getNext()) {
-            sorter->add(extractKey(*next), *next);
+        if (cursorsSource) {
+            populateFromCursors(cursorsSource->getCursors());
+        }
+        else if (commandsSource) {
+            populateFromBsonArrays(commandsSource->getArrays());
+        }
+        else {
+            // Anything else, such as the single shard of a splitMongodPipeline
+            // test, isn't known to be sorted so gets a full sort.
+            scoped_ptr<MySorter> sorter (MySorter::make(makeSortOptions(), Comparator(*this)));
+            while (boost::optional<Document> next = pSource->getNext()) {
+                sorter->add(extractKey(*next), *next);
+            }
+            _output.reset(sorter->done());
         }
 
-        _output.reset(sorter->done());
         populated = true;
     }
 
+    class DocumentSourceSort::IteratorFromCursor : public MySorter::Iterator {
+    public:
+        IteratorFromCursor(DocumentSourceSort* sorter,
+                           DocumentSourceMergeCursors* source,
+                           DBClientCursor* cursor)
+            : _sorter(sorter)
+            , _source(source)
+            , _cursor(cursor)
+        {}
+
+        bool more() { return _cursor->more(); }
+        Data next() {
+            const Document doc = _source->nextSafeFrom(_cursor);
+            return make_pair(_sorter->extractKey(doc), doc);
+        }
+    private:
+        DocumentSourceSort* _sorter;
+        DocumentSourceMergeCursors* _source;
+        DBClientCursor* _cursor;
+    };
+
+    void DocumentSourceSort::populateFromCursors(const vector<DBClientCursor*>& cursors) {
+        DocumentSourceMergeCursors* source = static_cast<DocumentSourceMergeCursors*>(pSource);
+
+        vector<boost::shared_ptr<MySorter::Iterator> > iterators;
+        for (size_t i = 0; i < cursors.size(); i++) {
+            iterators.push_back(boost::make_shared<IteratorFromCursor>(this, source, cursors[i]));
+        }
+
+        // the merge only reads from a shard when it needs that shard's next document
+        _output.reset(MySorter::Iterator::merge(iterators, makeSortOptions(), Comparator(*this)));
+    }
+
+    class DocumentSourceSort::IteratorFromBsonArray : public MySorter::Iterator {
+    public:
+        IteratorFromBsonArray(DocumentSourceSort* sorter, const BSONArray& array)
+            : _sorter(sorter)
+            , _iterator(array)
+        {}
+
+        bool more() { return _iterator.more(); }
+        Data next() {
+            Document doc(_iterator.next().Obj());
+            return make_pair(_sorter->extractKey(doc), doc);
+        }
+    private:
+        DocumentSourceSort* _sorter;
+        BSONObjIterator _iterator;
+    };
+
+    void DocumentSourceSort::populateFromBsonArrays(const vector<BSONArray>& arrays) {
+        vector<boost::shared_ptr<MySorter::Iterator> > iterators;
+        for (size_t i = 0; i < arrays.size(); i++) {
+            iterators.push_back(boost::make_shared<IteratorFromBsonArray>(this, arrays[i]));
+        }
+
+        _output.reset(MySorter::Iterator::merge(iterators, makeSortOptions(), Comparator(*this)));
+    }
+
     Value DocumentSourceSort::extractKey(const Document& d) const {
         if (vSortKey.size() == 1) {
             return vSortKey[0]->evaluate(d);
@@ -402,6 +402,10 @@ namespace mongo {
         return pExpression;
     }
 
+    intrusive_ptr<Expression> ExpressionAdd::optimize() {
+        return ExpressionCompiledArithmetic::compile(ExpressionNary::optimize());
+    }
+
     Value ExpressionAdd::evaluateInternal(const Variables& vars) const {
 
         /*
@@ -811,6 +815,221 @@ namespace mongo {
         return cmpLookup[cmpOp].name;
     }
 
+    /* ------------------ ExpressionCompiledArithmetic ---------------------- */
+
+    ExpressionCompiledArithmetic::ExpressionCompiledArithmetic(
+            const intrusive_ptr<Expression>& original)
+        : _original(original)
+    {}
+
+    intrusive_ptr<Expression> ExpressionCompiledArithmetic::compile(
+            const intrusive_ptr<Expression>& pExpression) {
+        const Expression* pE = pExpression.get();
+        if (!dynamic_cast<const ExpressionAdd*>(pE)
+                && !dynamic_cast<const ExpressionMultiply*>(pE)
+                && !dynamic_cast<const ExpressionSubtract*>(pE)
+                && !dynamic_cast<const ExpressionDivide*>(pE))
+            return pExpression;
+
+        intrusive_ptr<ExpressionCompiledArithmetic> pCompiled(
+            new ExpressionCompiledArithmetic(pExpression));
+        if (!pCompiled->emit(pE, 0))
+            return pExpression;
+
+        return pCompiled;
+    }
+
+    bool ExpressionCompiledArithmetic::emit(const Expression* pExpression, size_t depth) {
+        if (depth >= MaxStackDepth)
+            return false;
+
+        if (const ExpressionConstant* pConst =
+                dynamic_cast<const ExpressionConstant*>(pExpression)) {
+            const Value& value = pConst->getValue();
+            if (!value.numeric())
+                return false;
+
+            Instruction instruction = {PUSH_CONSTANT, static_cast<unsigned>(_constants.size())};
+            _constants.push_back(fromValue(value));
+            _program.push_back(instruction);
+            return true;
+        }
+
+        if (const ExpressionFieldPath* pField =
+                dynamic_cast<const ExpressionFieldPath*>(pExpression)) {
+            Instruction instruction = {PUSH_FIELD, static_cast<unsigned>(_fields.size())};
+            _fields.push_back(const_cast<ExpressionFieldPath*>(pField));
+            _program.push_back(instruction);
+            return true;
+        }
+
+        if (const ExpressionCompiledArithmetic* pCompiled =
+                dynamic_cast<const ExpressionCompiledArithmetic*>(pExpression)) {
+            return emit(pCompiled->_original.get(), depth);
+        }
+
+        OpCode op;
+        if (dynamic_cast<const ExpressionAdd*>(pExpression))
+            op = ADD;
+        else if (dynamic_cast<const ExpressionMultiply*>(pExpression))
+            op = MULTIPLY;
+        else if (dynamic_cast<const ExpressionSubtract*>(pExpression))
+            op = SUBTRACT;
+        else if (dynamic_cast<const ExpressionDivide*>(pExpression))
+            op = DIVIDE;
+        else
+            return false;
+
+        const ExpressionVector& operands =
+            static_cast<const ExpressionNary*>(pExpression)->vpOperand;
+        for (size_t i = 0; i < operands.size(); i++) {
+            if (!emit(operands[i].get(), depth + i))
+                return false;
+        }
+
+        Instruction instruction = {op, static_cast<unsigned>(operands.size())};
+        _program.push_back(instruction);
+        return true;
+    }
+
+    intrusive_ptr<Expression> ExpressionCompiledArithmetic::optimize() {
+        return this; // compiled from an already optimized tree
+    }
+
+    void ExpressionCompiledArithmetic::addDependencies(set<string>& deps,
+                                                       vector<string>* path) const {
+        _original->addDependencies(deps, path);
+    }
+
+    Value ExpressionCompiledArithmetic::serialize() const {
+        return _original->serialize();
+    }
+
+    ExpressionCompiledArithmetic::Number ExpressionCompiledArithmetic::makeInt(int value) {
+        Number number = {NumberInt, value, static_cast<double>(value)};
+        return number;
+    }
+
+    ExpressionCompiledArithmetic::Number ExpressionCompiledArithmetic::makeLong(long long value) {
+        Number number = {NumberLong, value, static_cast<double>(value)};
+        return number;
+    }
+
+    ExpressionCompiledArithmetic::Number ExpressionCompiledArithmetic::makeDouble(double value) {
+        Number number = {NumberDouble, static_cast<long long>(value), value};
+        return number;
+    }
+
+    ExpressionCompiledArithmetic::Number ExpressionCompiledArithmetic::makeIntOrLong(
+            long long value) {
+        const int intValue = value;
+        if (intValue != value)
+            return makeLong(value);
+        return makeInt(intValue);
+    }
+
+    ExpressionCompiledArithmetic::Number ExpressionCompiledArithmetic::fromValue(
+            const Value& value) {
+        switch (value.getType()) {
+        case NumberInt: return makeInt(value.getInt());
+        case NumberLong: return makeLong(value.getLong());
+        case NumberDouble: return makeDouble(value.getDouble());
+        default: verify(false);
+        }
+    }
+
+    Value ExpressionCompiledArithmetic::toValue(const Number& number) {
+        switch (number.type) {
+        case NumberInt: return Value(static_cast<int>(number.longValue));
+        case NumberLong: return Value(number.longValue);
+        case NumberDouble: return Value(number.doubleValue);
+        default: verify(false);
+        }
+    }
+
+    Value ExpressionCompiledArithmetic::evaluateInternal(const Variables& vars) const {
+        // The arithmetic below mirrors the evaluateInternal() of each of the expressions.
+        Number stack[MaxStackDepth];
+        size_t top = 0; // number of entries on the stack
+
+        for (vector<Instruction>::const_iterator it = _program.begin(), end = _program.end();
+                it != end; ++it) {
+            switch (it->op) {
+            case PUSH_CONSTANT:
+                stack[top++] = _constants[it->arg];
+                break;
+
+            case PUSH_FIELD: {
+                const Value value = _fields[it->arg]->evaluateInternal(vars);
+                if (!value.numeric())
+                    return _original->evaluateInternal(vars); // nulls, dates and errors
+                stack[top++] = fromValue(value);
+                break;
+            }
+
+            case ADD:
+            case MULTIPLY: {
+                const bool add = it->op == ADD;
+                BSONType type = NumberInt;
+                long long longTotal = add ? 0 : 1;
+                double doubleTotal = add ? 0 : 1;
+
+                top -= it->arg;
+                for (size_t i = top; i < top + it->arg; i++) {
+                    type = Value::getWidestNumeric(type, stack[i].type);
+                    if (add) {
+                        longTotal += stack[i].longValue;
+                        doubleTotal += stack[i].doubleValue;
+                    }
+                    else {
+                        longTotal *= stack[i].longValue;
+                        doubleTotal *= stack[i].doubleValue;
+                    }
+                }
+
+                if (type == NumberDouble)
+                    stack[top++] = makeDouble(doubleTotal);
+                else if (type == NumberLong)
+                    stack[top++] = makeLong(longTotal);
+                else
+                    stack[top++] = makeIntOrLong(longTotal);
+                break;
+            }
+
+            case SUBTRACT: {
+                const Number& left = stack[top - 2];
+                const Number& right = stack[top - 1];
+                const BSONType type = Value::getWidestNumeric(right.type, left.type);
+
+                Number result;
+                if (type == NumberDouble)
+                    result = makeDouble(left.doubleValue - right.doubleValue);
+                else if (type == NumberLong)
+                    result = makeLong(left.longValue - right.longValue);
+                else
+                    result = makeIntOrLong(left.longValue - right.longValue);
+
+                stack[--top - 1] = result;
+                break;
+            }
+
+            case DIVIDE: {
+                const Number& left = stack[top - 2];
+                const Number& right = stack[top - 1];
+                if (right.doubleValue == 0)
+                    return _original->evaluateInternal(vars); // for the error
+
+                const Number result = makeDouble(left.doubleValue / right.doubleValue);
+                stack[--top - 1] = result;
+                break;
+            }
+            }
+        }
+
+        dassert(top == 1);
+        return toValue(stack[0]);
+    }
+
     /* ------------------------- ExpressionConcat ----------------------------- */
 
     intrusive_ptr<ExpressionNary> ExpressionConcat::create() {
@@ -957,6 +1176,10 @@ namespace mongo {
         return pExpression;
     }
 
+    intrusive_ptr<Expression> ExpressionDivide::optimize() {
+        return ExpressionCompiledArithmetic::compile(ExpressionNary::optimize());
+    }
+
     Value ExpressionDivide::evaluateInternal(const Variables& vars) const {
         Value lhs = vpOperand[0]->evaluateInternal(vars);
         Value rhs = vpOperand[1]->evaluateInternal(vars);
@@ -1385,6 +1608,19 @@ namespace mongo {
         }
     }
 
+    Value ExpressionFieldPath::evaluateFromField(const Value& field) const {
+        dassert(isPathInDocument());
+
+        if (_fieldPath.getPathLength() == 2)
+            return field;
+
+        switch (field.getType()) {
+        case Object: return evaluatePath(2, field.getDocument());
+        case Array: return evaluatePathArray(2, field);
+        default: return Value();
+        }
+    }
+
     Value ExpressionFieldPath::serialize() const {
         if (_fieldPath.getFieldName(0) == "CURRENT" && _fieldPath.getPathLength() > 1) {
             // use short form for "$$CURRENT.foo" but not just "$$CURRENT"
@@ -2006,6 +2242,10 @@ namespace mongo {
         return pExpression;
     }
 
+    intrusive_ptr<Expression> ExpressionMultiply::optimize() {
+        return ExpressionCompiledArithmetic::compile(ExpressionNary::optimize());
+    }
+
     Value ExpressionMultiply::evaluateInternal(const Variables& vars) const {
         /*
           We'll try to return the narrowest possible result value.  To do that
@@ -2181,6 +2421,14 @@ namespace mongo {
                 */
                 ExpressionNary *pNary =
                     dynamic_cast<ExpressionNary *>(pE.get());
+                if (!pNary) {
+                    // look through a compiled child so it can still be flattened
+                    ExpressionCompiledArithmetic* pCompiled =
+                        dynamic_cast<ExpressionCompiledArithmetic *>(pE.get());
+                    if (pCompiled)
+                        pNary = dynamic_cast<ExpressionNary *>(pCompiled->getOriginal().get());
+                }
+
                 if (!pNary)
                     pNew->addOperand(pE);
                 else {
@@ -2683,6 +2931,10 @@ namespace mongo {
         return pExpression;
     }
 
+    intrusive_ptr<Expression> ExpressionSubtract::optimize() {
+        return ExpressionCompiledArithmetic::compile(ExpressionNary::optimize());
+    }
+
     Value ExpressionSubtract::evaluateInternal(const Variables& vars) const {
         Value lhs = vpOperand[0]->evaluateInternal(vars);
         Value rhs = vpOperand[1]->evaluateInternal(vars);
@@ -261,6 +261,8 @@ namespace mongo {
         ExpressionNary() {}
 
         ExpressionVector vpOperand;
+
+        friend class ExpressionCompiledArithmetic;
     };
 
 
@@ -268,6 +270,7 @@ namespace mongo {
         public ExpressionNary {
     public:
         // virtuals from Expression
+        virtual intrusive_ptr<Expression> optimize();
         virtual Value evaluateInternal(const Variables& vars) const;
         virtual const char *getOpName() const;
 
@@ -488,6 +491,7 @@ namespace mongo {
         public ExpressionNary {
     public:
         // virtuals from ExpressionNary
+        virtual intrusive_ptr<Expression> optimize();
         virtual Value evaluateInternal(const Variables& vars) const;
         virtual const char *getOpName() const;
 
@@ -527,6 +531,17 @@ namespace mongo {
 
         const FieldPath& getFieldPath() const { return _fieldPath; }
 
+        /// True for a path into a field of the input document, such as "$a.b" or "$$ROOT.a".
+        bool isPathInDocument() const {
+            return _baseVar != OTHER && _fieldPath.getPathLength() > 1;
+        }
+
+        /**
+         * For a path where isPathInDocument() is true, returns what evaluating it would, given
+         * the value of the document's top-level field it starts with ('a' for "$a.b.c").
+         */
+        Value evaluateFromField(const Value& field) const;
+
     private:
         ExpressionFieldPath(const string &fieldPath);
 
@@ -560,6 +575,79 @@ namespace mongo {
     };
 
 
+    /**
+     * A tree of $add, $subtract, $multiply and $divide over field paths and numeric constants,
+     * compiled into a flat postfix program by the optimize() of those expressions.
+     *
+     * Intermediate results stay unboxed on a small stack instead of becoming Values, and the
+     * only virtual calls are for the field paths.  Whenever the program meets something it
+     * doesn't handle (a field that isn't a number, a division by zero) the original tree is
+     * evaluated instead, so results, types and errors are exactly those of the original.
+     */
+    class ExpressionCompiledArithmetic :
+        public Expression {
+    public:
+        // virtuals from Expression
+        virtual intrusive_ptr<Expression> optimize();
+        virtual void addDependencies(set<string>& deps, vector<string>* path=NULL) const;
+        virtual Value evaluateInternal(const Variables& vars) const;
+        virtual Value serialize() const;
+
+        /**
+          Compile an optimized arithmetic expression.
+
+          @param pExpression the expression to compile
+          @returns the compiled expression, or pExpression itself if it
+            isn't an arithmetic tree that can be compiled
+         */
+        static intrusive_ptr<Expression> compile(const intrusive_ptr<Expression>& pExpression);
+
+        /// The tree this was compiled from; it is what gets serialized.
+        const intrusive_ptr<Expression>& getOriginal() const { return _original; }
+
+    private:
+        explicit ExpressionCompiledArithmetic(const intrusive_ptr<Expression>& original);
+
+        enum OpCode {
+            PUSH_CONSTANT, // push _constants[arg]
+            PUSH_FIELD,    // evaluate and push _fields[arg]
+            ADD,           // replace the top arg entries with their sum
+            MULTIPLY,      // replace the top arg entries with their product
+            SUBTRACT,      // replace the top 2 entries with their difference
+            DIVIDE,        // replace the top 2 entries with their quotient
+        };
+
+        struct Instruction {
+            OpCode op;
+            unsigned arg;
+        };
+
+        /// An unboxed numeric Value, holding what coerceToLong() and coerceToDouble() return.
+        struct Number {
+            BSONType type; // NumberInt, NumberLong or NumberDouble
+            long long longValue;
+            double doubleValue;
+        };
+
+        static Number makeInt(int value);
+        static Number makeLong(long long value);
+        static Number makeDouble(double value);
+        static Number makeIntOrLong(long long value); // like Value::createIntOrLong()
+        static Number fromValue(const Value& value);
+        static Value toValue(const Number& number);
+
+        /// Append the program for pExpression, whose result lands at stack index 'depth'.
+        bool emit(const Expression* pExpression, size_t depth);
+
+        static const size_t MaxStackDepth = 32;
+
+        intrusive_ptr<Expression> _original;
+        vector<Instruction> _program;
+        vector<Number> _constants;
+        vector<intrusive_ptr<ExpressionFieldPath> > _fields;
+    };
+
+
     class ExpressionFieldRange :
         public Expression {
     public:
@@ -750,6 +838,7 @@ namespace mongo {
         public ExpressionNary {
     public:
         // virtuals from Expression
+        virtual intrusive_ptr<Expression> optimize();
         virtual Value evaluateInternal(const Variables& vars) const;
         virtual const char *getOpName() const;
 
@@ -1070,6 +1159,7 @@ namespace mongo {
         public ExpressionNary {
     public:
         // virtuals from ExpressionNary
+        virtual intrusive_ptr<Expression> optimize();
         virtual Value evaluateInternal(const Variables& vars) const;
         virtual const char *getOpName() const;
 
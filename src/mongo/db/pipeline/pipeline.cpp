@@ -218,7 +218,9 @@ namespace mongo {
             intrusive_ptr<DocumentSource> &pSource = sources[srci];
             if (dynamic_cast<DocumentSourceMatch *>(pSource.get())) {
                 intrusive_ptr<DocumentSource> &pPrevious = sources[srci - 1];
-                if (dynamic_cast<DocumentSourceSort *>(pPrevious.get())) {
+                DocumentSourceSort* pSort = dynamic_cast<DocumentSourceSort *>(pPrevious.get());
+                // a merging $sort has to read straight from the shards
+                if (pSort && !pSort->isMergingPresorted()) {
                     /* swap this item with the previous */
                     intrusive_ptr<DocumentSource> pTemp(pPrevious);
                     pPrevious = pSource;
@@ -25,11 +25,15 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query_optimizer.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/d_logic.h"
 
 
 namespace mongo {
 
+    // Number of threads to run the part of a pipeline up to its first $group on.  1 disables it.
+    MONGO_EXPORT_SERVER_PARAMETER(internalAggregationWorkerThreads, int, 1);
+
 namespace {
     class MongodImplementation : public DocumentSourceNeedsMongod::MongodInterface {
     public:
@@ -267,4 +271,63 @@ namespace {
         pPipeline->addInitialSource(pSource);
     }
 
+    void PipelineD::prepareParallelSources(
+        const intrusive_ptr<Pipeline> &pPipeline,
+        const intrusive_ptr<ExpressionContext> &pExpCtx) {
+
+        if (internalAggregationWorkerThreads <= 1 || pPipeline->isExplain())
+            return;
+
+        Pipeline::SourceContainer& sources = pPipeline->sources;
+        if (sources.empty())
+            return;
+
+        DocumentSourceCursor* cursorSource =
+            dynamic_cast<DocumentSourceCursor*>(sources.front().get());
+        if (!cursorSource)
+            return; // e.g. $geoNear, which does its own reading
+
+        // The workers see the input in no particular order, so an absorbed $sort would be lost.
+        if (!cursorSource->getSort().isEmpty())
+            return;
+
+        // Only stages that look at one document at a time can run ahead of the $group.
+        DocumentSourceGroup* group = NULL;
+        for (size_t i = 1; i < sources.size() && !group; i++) {
+            DocumentSource* source = sources[i].get();
+            if ((group = dynamic_cast<DocumentSourceGroup*>(source))) {
+                // found it
+            }
+            else if (!dynamic_cast<DocumentSourceMatch*>(source)
+                     && !dynamic_cast<DocumentSourceProject*>(source)
+                     && !dynamic_cast<DocumentSourceUnwind*>(source)) {
+                return;
+            }
+        }
+
+        if (!group || group->dependsOnInputOrder())
+            return;
+
+        const int nWorkers =
+            DocumentSourceParallel::reserveWorkers(internalAggregationWorkerThreads);
+        if (nWorkers == 0)
+            return; // too many running already, do this one on the calling thread
+
+        intrusive_ptr<Pipeline> pShardPipeline;
+        intrusive_ptr<DocumentSource> input = sources.front();
+        try {
+            sources.pop_front();
+
+            // this leaves the merging half in pPipeline
+            pShardPipeline = pPipeline->splitForSharded();
+        }
+        catch (...) {
+            DocumentSourceParallel::releaseWorkers(nWorkers);
+            throw;
+        }
+
+        pPipeline->addInitialSource(
+            DocumentSourceParallel::create(input, pShardPipeline, nWorkers, pExpCtx));
+    }
+
 } // namespace mongo
@@ -57,6 +57,29 @@ namespace mongo {
             const string &dbName,
             const intrusive_ptr<ExpressionContext> &pExpCtx);
 
+        /**
+           Split the pipeline so that the stages up to and including its
+           first $group run on several threads, when the
+           internalAggregationWorkerThreads server parameter allows it.
+
+           The pipeline is split as it would be for sharding: each worker
+           runs the shard half on part of the input and the merging half
+           combines their partial groups.  Pipelines that have anything
+           other than $match, $project or $unwind before the $group are
+           left alone, as are explains, sorted cursors and groups whose
+           accumulators depend on input order ($first, $last, $push).  The
+           number of worker threads is also capped across all aggregations;
+           when none are free the pipeline runs on the calling thread.
+
+           Must be called after prepareCursorSource() and before stitch().
+
+           @param pPipeline the logical "this" for this operation
+           @param pExpCtx the expression context for this pipeline
+         */
+        static void prepareParallelSources(
+            const intrusive_ptr<Pipeline> &pPipeline,
+            const intrusive_ptr<ExpressionContext> &pExpCtx);
+
     private:
         PipelineD(); // does not exist:  prevent instantiation
     };
@@ -18,6 +18,7 @@
 
 #include "mongo/db/prefetch.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/diskloc.h"
 #include "mongo/db/index/catalog_hack.h"
@@ -28,6 +29,7 @@
 #include "mongo/db/repl/rs.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/util/mmap.h"
 
 namespace mongo {
 
@@ -44,30 +46,46 @@ namespace mongo {
     static ServerStatusMetricField<TimerStats> displayPrefetchDocPages(
                                                     "repl.preload.docs",
                                                     &prefetchDocStats );
+    // Whether the first page of each record prefetched for an update was already in memory
+    static Counter64 prefetchDocsInMemoryStats;
+    static ServerStatusMetricField<Counter64> displayPrefetchDocsInMemory(
+                                                    "repl.preload.docsInMemory",
+                                                    &prefetchDocsInMemoryStats );
+    static Counter64 prefetchDocsNotInMemoryStats;
+    static ServerStatusMetricField<Counter64> displayPrefetchDocsNotInMemory(
+                                                    "repl.preload.docsNotInMemory",
+                                                    &prefetchDocsNotInMemoryStats );
 
     // prefetch for an oplog operation
     void prefetchPagesForReplicatedOp(const BSONObj& op) {
-        const char *opField;
-        const char *opType = op.getStringField("op");
-        switch (*opType) {
-        case 'i': // insert
-        case 'd': // delete
-            opField = "o";
-            break;
-        case 'u': // update
-            opField = "o2";
-            break;
-        default:
-            // prefetch ignores other ops
-            return;
-        }
-         
-        BSONObj obj = op.getObjectField(opField);
-        const char *ns = op.getStringField("ns");
+        prefetchPagesForReplicatedOps(op.getStringField("ns"), std::vector<BSONObj>(1, op));
+    }
+
+    void prefetchPagesForReplicatedOps(const char *ns, const std::vector<BSONObj>& ops) {
         NamespaceDetails *nsd = nsdetails(ns);
         if (!nsd) return; // maybe not opened yet
-        
-        LOG(4) << "index prefetch for op " << *opType << endl;
+
+        std::vector<BSONObj> indexObjs;
+        std::vector<BSONObj> updatedObjs;
+        for (std::vector<BSONObj>::const_iterator it = ops.begin(); it != ops.end(); ++it) {
+            const char *opType = it->getStringField("op");
+            switch (*opType) {
+            case 'i': // insert
+            case 'd': // delete
+                indexObjs.push_back(it->getObjectField("o"));
+                break;
+            case 'u': // update
+                indexObjs.push_back(it->getObjectField("o2"));
+                updatedObjs.push_back(indexObjs.back());
+                break;
+            default:
+                // prefetch ignores other ops
+                break;
+            }
+        }
+        if (indexObjs.empty()) return;
+
+        LOG(4) << "index prefetch for " << indexObjs.size() << " ops on " << ns << endl;
 
         DEV Lock::assertAtLeastReadLocked(ns);
 
@@ -86,7 +104,7 @@ namespace mongo {
         // a way to achieve that would be to prefetch the record first, and then afterwards do 
         // this part.
         //
-        prefetchIndexPages(nsd, obj);
+        prefetchIndexPages(nsd, indexObjs);
 
         // do not prefetch the data for inserts; it doesn't exist yet
         // 
@@ -94,17 +112,19 @@ namespace mongo {
         // when we delete.  note if done we only want to touch the first page.
         // 
         // update: do record prefetch. 
-        if ((*opType == 'u') &&
-            // do not prefetch the data for capped collections because
-            // they typically do not have an _id index for findById() to use.
-            !nsd->isCapped()) {
-            prefetchRecordPages(ns, obj);
+        //
+        // do not prefetch the data for capped collections because
+        // they typically do not have an _id index for findById() to use.
+        if (!updatedObjs.empty() && !nsd->isCapped()) {
+            prefetchRecordPages(nsd, updatedObjs);
         }
     }
 
     void prefetchIndexPages(NamespaceDetails *nsd, const BSONObj& obj) {
-        DiskLoc unusedDl; // unused
-        BSONObjSet unusedKeys;
+        prefetchIndexPages(nsd, std::vector<BSONObj>(1, obj));
+    }
+
+    void prefetchIndexPages(NamespaceDetails *nsd, const std::vector<BSONObj>& objs) {
         ReplSetImpl::IndexPrefetchConfig prefetchConfig = theReplSet->getIndexPrefetchConfig();
 
         // do we want prefetchConfig to be (1) as-is, (2) for update ops only, or (3) configured per op type?  
@@ -123,7 +143,7 @@ namespace mongo {
             try {
                 auto_ptr<IndexDescriptor> desc(CatalogHack::getDescriptor(nsd, indexNo));
                 auto_ptr<IndexAccessMethod> iam(CatalogHack::getIndex(desc.get()));
-                iam->touch(obj);
+                iam->touch(objs);
             }
             catch (const DBException& e) {
                 LOG(2) << "ignoring exception in prefetchIndexPages(): " << e.what() << endl;
@@ -137,16 +157,15 @@ namespace mongo {
             int indexCount = nsd->getTotalIndexCount();
             for ( int indexNo = 0; indexNo < indexCount; indexNo++ ) {
                 TimerHolder timer( &prefetchIndexStats);
-                // This will page in all index pages for the given object.
+                // This will page in all index pages for the given objects.
                 try {
                     auto_ptr<IndexDescriptor> desc(CatalogHack::getDescriptor(nsd, indexNo));
                     auto_ptr<IndexAccessMethod> iam(CatalogHack::getIndex(desc.get()));
-                    iam->touch(obj);
+                    iam->touch(objs);
                 }
                 catch (const DBException& e) {
                     LOG(2) << "ignoring exception in prefetchIndexPages(): " << e.what() << endl;
                 }
-                unusedKeys.clear();
             }
             break;
         }
@@ -157,30 +176,83 @@ namespace mongo {
 
 
     void prefetchRecordPages(const char* ns, const BSONObj& obj) {
-        BSONElement _id;
-        if( obj.getObjectID(_id) ) {
-            TimerHolder timer(&prefetchDocStats);
-            BSONObjBuilder builder;
-            builder.append(_id);
-            BSONObj result;
-            try {
-                // we can probably use Client::Context here instead of ReadContext as we
-                // have locked higher up the call stack already
-                Client::ReadContext ctx( ns );
-                if( Helpers::findById(cc(), ns, builder.done(), result) ) {
-                    // do we want to use Record::touch() here?  it's pretty similar.
-                    volatile char _dummy_char = '\0';
-                    // Touch the first word on every page in order to fault it into memory
-                    for (int i = 0; i < result.objsize(); i += g_minOSPageSizeBytes) {                        
-                        _dummy_char += *(result.objdata() + i); 
-                    }
-                    // hit the last page, in case we missed it above
-                    _dummy_char += *(result.objdata() + result.objsize() - 1);
+        try {
+            // we can probably use Client::Context here instead of ReadContext as we
+            // have locked higher up the call stack already
+            Client::ReadContext ctx( ns );
+            NamespaceDetails *nsd = nsdetails(ns);
+            if (nsd) {
+                prefetchRecordPages(nsd, std::vector<BSONObj>(1, obj));
+            }
+        }
+        catch(const DBException& e) {
+            LOG(2) << "ignoring exception in prefetchRecordPages(): " << e.what() << endl;
+        }
+    }
+
+    void prefetchRecordPages(NamespaceDetails *nsd, const std::vector<BSONObj>& objs) {
+        if (nsd->findIdIndex() == -1) return;
+
+        // look the records up in _id order so the _id index walks share their path
+        BSONObjSet ids;
+        for (std::vector<BSONObj>::const_iterator it = objs.begin(); it != objs.end(); ++it) {
+            BSONElement _id;
+            if (it->getObjectID(_id)) {
+                BSONObjBuilder builder;
+                builder.append(_id);
+                ids.insert(builder.obj());
+            }
+        }
+        if (ids.empty()) return;
+
+        TimerHolder timer(&prefetchDocStats);
+        try {
+            // Ask for the first page of every record before reading any of them, so the reads
+            // are in flight together instead of faulting one record at a time.
+            std::vector<Record*> records;
+            for (BSONObjSet::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+                DiskLoc loc = Helpers::findById(nsd, *it);
+                if (loc.isNull()) continue;
+
+                Record *r = loc.rec();
+                if (Record::likelyInPhysicalMemory(r->dataNoThrowing())) {
+                    prefetchDocsInMemoryStats.increment();
+                }
+                else {
+                    prefetchDocsNotInMemoryStats.increment();
+                    adviseWillNeed(r, Record::HeaderSize);
+                }
+                records.push_back(r);
+            }
+
+            // The length is in the header, so only now can the rest of a large record be asked
+            // for.
+            for (std::vector<Record*>::const_iterator it = records.begin();
+                 it != records.end();
+                 ++it) {
+                int len = (*it)->lengthWithHeaders();
+                if (len > static_cast<int>(g_minOSPageSizeBytes)) {
+                    adviseWillNeed(*it, len);
                 }
             }
-            catch(const DBException& e) {
-                LOG(2) << "ignoring exception in prefetchRecordPages(): " << e.what() << endl;
+
+            // madvise is only a hint, so still fault in every page before returning: the writer
+            // applying the batch must not be the one waiting on them.
+            volatile char _dummy_char = '\0';
+            for (std::vector<Record*>::const_iterator it = records.begin();
+                 it != records.end();
+                 ++it) {
+                BSONObj obj((*it)->dataNoThrowing());
+                // Touch the first word on every page in order to fault it into memory
+                for (int i = 0; i < obj.objsize(); i += g_minOSPageSizeBytes) {
+                    _dummy_char += *(obj.objdata() + i);
+                }
+                // hit the last page, in case we missed it above
+                _dummy_char += *(obj.objdata() + obj.objsize() - 1);
             }
         }
+        catch(const DBException& e) {
+            LOG(2) << "ignoring exception in prefetchRecordPages(): " << e.what() << endl;
+        }
     }
 }
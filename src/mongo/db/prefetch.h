@@ -23,9 +23,20 @@ namespace mongo {
     // page in both index and data pages for an op from the oplog
     void prefetchPagesForReplicatedOp(const BSONObj& op);
 
+    // page in both index and data pages for a group of ops from the oplog, all on namespace ns
+    void prefetchPagesForReplicatedOps(const char *ns, const std::vector<BSONObj>& ops);
+
     // page in pages needed for all index lookups on a given object
     void prefetchIndexPages(NamespaceDetails *nsd, const BSONObj& obj);
 
+    // page in pages needed for all index lookups on the given objects, doing the lookups for
+    // each index in key order
+    void prefetchIndexPages(NamespaceDetails *nsd, const std::vector<BSONObj>& objs);
+
     // page in the data pages for a record associated with an object
     void prefetchRecordPages(const char *ns, const BSONObj& obj);
+
+    // start paging in the data pages for the records associated with the given objects, without
+    // waiting for all of them
+    void prefetchRecordPages(NamespaceDetails *nsd, const std::vector<BSONObj>& objs);
 }
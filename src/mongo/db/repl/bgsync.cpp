@@ -337,6 +337,11 @@ namespace replset {
             return;
         }
 
+        // From here on the connection is only used by the cursor, so the source can be working
+        // on the next batch while this one is queued.  Not once we are caught up though: the
+        // wait for small batches below needs the getMore to go out after it.
+        r.prefetchBatches(BatchIsSmallish);
+
         while (!inShutdown()) {
             if (!r.moreInCurrentBatch()) {
                 // Check some things periodically
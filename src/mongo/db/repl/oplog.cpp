@@ -102,20 +102,14 @@ namespace mongo {
         OpTime::setLast( ts );
     }
 
-    /** given a BSON object, create a new one at dst which is the existing (partial) object
-        with a new object element appended at the end with fieldname "o".
+    /** the size of the object append_O_Obj() creates */
+    static int o_ObjSize(const BSONObj& partial, const BSONObj& o) {
+        return partial.objsize() + o.objsize() + 1 + 2 /*o:*/;
+    }
 
-        @param partial already build object with everything except the o member.  e.g. something like:
-               { ts:..., ns:..., os2:... }
-        @param o a bson object to be added with fieldname "o"
-        @dst   where to put the newly built combined object.  e.g. ends up as something like:
-               { ts:..., ns:..., os2:..., o:... }
-    */
-    void append_O_Obj(char *dst, const BSONObj& partial, const BSONObj& o) {
+    /** append_O_Obj() for a dst the caller has already declared a write intent for */
+    static void write_O_Obj(void *p, const BSONObj& partial, const BSONObj& o) {
         const int size1 = partial.objsize() - 1;  // less the EOO char
-        const int oOfs = size1+3;                 // 3 = byte BSONOBJTYPE + byte 'o' + byte \0
-
-        void *p = getDur().writingPtr(dst, oOfs+o.objsize()+1);
 
         memcpy(p, partial.objdata(), size1);
 
@@ -132,6 +126,19 @@ namespace mongo {
         *b = EOO;
     }
 
+    /** given a BSON object, create a new one at dst which is the existing (partial) object
+        with a new object element appended at the end with fieldname "o".
+
+        @param partial already build object with everything except the o member.  e.g. something like:
+               { ts:..., ns:..., os2:... }
+        @param o a bson object to be added with fieldname "o"
+        @dst   where to put the newly built combined object.  e.g. ends up as something like:
+               { ts:..., ns:..., os2:..., o:... }
+    */
+    void append_O_Obj(char *dst, const BSONObj& partial, const BSONObj& o) {
+        write_O_Obj(getDur().writingPtr(dst, o_ObjSize(partial, o)), partial, o);
+    }
+
     /* we write to local.oplog.rs:
          { ts : ..., h: ..., v: ..., op: ..., etc }
        ts: an OpTime timestamp
@@ -232,6 +239,75 @@ namespace mongo {
         LOG( 6 ) << "logOp:" << BSONObj::make(r) << endl;
     }
 
+    /* _logOpRS() of an "i" entry for each of objs.  all of the entry headers are built in
+       logopbufbuilder first, then the entries go into one allocation in the oplog which is
+       declared as written once.
+    */
+    static void _logInsertsRS(const char *ns, const vector<BSONObj>& objs) {
+        Lock::DBWrite lk1("local");
+
+        if ( strncmp(ns, "local.", 6) == 0 || !theReplSet ) {
+            for ( size_t i = 0; i < objs.size(); i++ )
+                _logOpRS("i", ns, 0, objs[i], 0, 0, false);
+            return;
+        }
+
+        mutex::scoped_lock lk2(OpTime::m);
+        massert(13312, "replSet error : logOp() but not primary?", theReplSet->box.getState().primary());
+
+        logopbufbuilder.reset();
+        vector<int> partialOfs;
+        OpTime ts;
+        long long hashNew = theReplSet->lastH;
+        for ( size_t i = 0; i < objs.size(); i++ ) {
+            ts = OpTime::now(lk2);
+            hashNew = (hashNew * 131 + ts.asLL()) * 17 + theReplSet->selfId();
+
+            partialOfs.push_back( logopbufbuilder.len() );
+            BSONObjBuilder b(logopbufbuilder);
+            b.appendTimestamp("ts", ts.asDate());
+            b.append("h", hashNew);
+            b.append("v", OPLOG_VERSION);
+            b.append("op", "i");
+            b.append("ns", ns);
+            b.done();
+        }
+
+        // the buffer may have moved while it grew, so only now point into it
+        vector<BSONObj> partials;
+        vector<int> lens;
+        for ( size_t i = 0; i < objs.size(); i++ ) {
+            partials.push_back( BSONObj( logopbufbuilder.buf() + partialOfs[i] ) );
+            lens.push_back( o_ObjSize( partials[i], objs[i] ) );
+        }
+
+        vector<Record*> records;
+        {
+            const char *logns = rsoplog;
+            if ( rsOplogDetails == 0 ) {
+                Client::Context ctx(logns , dbpath);
+                localDB = ctx.db();
+                verify( localDB );
+                rsOplogDetails = nsdetails(logns);
+                massert(13347, "local.oplog.rs missing. did you drop it? if so restart server", rsOplogDetails);
+            }
+            Client::Context ctx(logns , localDB);
+            theDataFileMgr.fast_oplog_insert(rsOplogDetails, logns, lens, &records);
+            if( !(theReplSet->lastOpTimeWritten<ts) ) {
+                log() << "replSet ERROR possible failover clock skew issue? " << theReplSet->lastOpTimeWritten << ' ' << ts << rsLog;
+                log() << "replSet " << theReplSet->isPrimary() << rsLog;
+            }
+            theReplSet->lastOpTimeWritten = ts;
+            theReplSet->lastH = hashNew;
+            ctx.getClient()->setLastOp( ts );
+        }
+
+        for ( size_t i = 0; i < objs.size(); i++ ) {
+            write_O_Obj(records[i]->data(), partials[i], objs[i]);
+            LOG( 6 ) << "logOp:" << BSONObj::make(records[i]) << endl;
+        }
+    }
+
     static void _logOpOld(const char *opstr, const char *ns, const char *logNS, const BSONObj& obj, BSONObj *o2, bool *bb, bool fromMigrate ) {
         Lock::DBWrite lk("local");
         static BufBuilder bufbuilder(8*1024); // todo there is likely a mutex on this constructor
@@ -337,6 +413,24 @@ namespace mongo {
         logOpForSharding(opstr, ns, obj, patt, fullObj, fromMigrate);
     }
 
+    void logInserts(const char* ns, const vector<BSONObj>& objs) {
+        if ( objs.empty() )
+            return;
+
+        if ( replSettings.master ) {
+            if ( _logOp == _logOpRS ) {
+                _logInsertsRS(ns, objs);
+            }
+            else {
+                for ( size_t i = 0; i < objs.size(); i++ )
+                    _logOp("i", ns, 0, objs[i], 0, 0, false);
+            }
+        }
+
+        for ( size_t i = 0; i < objs.size(); i++ )
+            logOpForSharding("i", ns, objs[i], 0, 0, false);
+    }
+
     void createOplog() {
         Lock::GlobalWrite lk;
 
@@ -58,6 +58,11 @@ namespace mongo {
                 BSONObj *patt = NULL, bool *b = NULL, bool fromMigrate = false,
                 const BSONObj* fullObj = NULL );
 
+    /** logOp() of an "i" entry for each of objs, all inserted into ns by one write.  on a
+        replica set the entries are written to the oplog together.
+    */
+    void logInserts( const char *ns, const vector<BSONObj>& objs );
+
     // Log an empty no-op operation to the local oplog
     void logKeepalive();
 
@@ -122,6 +122,14 @@ namespace mongo {
             return cursor->getMessage()->size();
         }
 
+        /* keep the next getMore in flight while the current batch is read, as long as batches
+           are at least minBatchBytes.  nothing else may be sent on this connection until the
+           cursor is reset, and the connection is dropped if a getMore is outstanding then. */
+        void prefetchBatches(int minBatchBytes) {
+            uassert( 17056, "Doesn't have cursor for reading oplog", cursor.get() );
+            cursor->setPrefetch(true, minBatchBytes);
+        }
+
         /* old mongod's can't do the await flag... */
         bool awaitCapable() {
             return cursor->hasResultFlag(ResultFlag_AwaitCapable);
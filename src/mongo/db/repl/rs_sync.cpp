@@ -122,6 +122,9 @@ namespace replset {
         }
     }
 
+    // Fewest ops on one namespace handed to a prefetch thread at a time
+    static const size_t prefetchMinGroupSize = 8;
+
     static AtomicUInt32 replWriterWorkerId;
     void initializeWriterThread() {
         // Only do this once per thread
@@ -189,35 +192,53 @@ namespace replset {
     }
 
 
-    // The pool threads call this to prefetch each op
-    void SyncTail::prefetchOp(const BSONObj& op) {
+    // The pool threads call this to prefetch each group of ops
+    void SyncTail::prefetchOpGroup(const std::vector<BSONObj>& ops) {
         initializePrefetchThread();
 
-        const char *ns = op.getStringField("ns");
-        if (ns && (ns[0] != '\0')) {
-            try {
-                // one possible tweak here would be to stay in the read lock for this database 
-                // for multiple prefetches if they are for the same database.
-                Client::ReadContext ctx(ns);
-                prefetchPagesForReplicatedOp(op);
-            }
-            catch (const DBException& e) {
-                LOG(2) << "ignoring exception in prefetchOp(): " << e.what() << endl;
-            }
-            catch (const std::exception& e) {
-                log() << "Unhandled std::exception in prefetchOp(): " << e.what() << endl;
-                fassertFailed(16397);
-            }
+        const char *ns = ops.front().getStringField("ns");
+        try {
+            Client::ReadContext ctx(ns);
+            prefetchPagesForReplicatedOps(ns, ops);
+        }
+        catch (const DBException& e) {
+            LOG(2) << "ignoring exception in prefetchOpGroup(): " << e.what() << endl;
+        }
+        catch (const std::exception& e) {
+            log() << "Unhandled std::exception in prefetchOpGroup(): " << e.what() << endl;
+            fassertFailed(16397);
         }
     }
 
-    // Doles out all the work to the reader pool threads and waits for them to complete
+    // Doles out all the work to the reader pool threads and waits for them to complete.
+    // Ops on one namespace go to a thread together, so it takes the lock once and can do the
+    // index lookups of the group in key order.  The groups are kept small enough that every
+    // thread gets some.
     void SyncTail::prefetchOps(const std::deque<BSONObj>& ops) {
         threadpool::ThreadPool& prefetcherPool = theReplSet->getPrefetchPool();
+        const size_t groupSize = std::max(prefetchMinGroupSize,
+                                          ops.size() / ReplSetImpl::replPrefetcherThreadCount + 1);
+
+        map<string, std::vector<BSONObj> > groups;
         for (std::deque<BSONObj>::const_iterator it = ops.begin();
              it != ops.end();
              ++it) {
-            prefetcherPool.schedule(&prefetchOp, *it);
+            const char *ns = it->getStringField("ns");
+            if (ns[0] == '\0') continue;
+
+            std::vector<BSONObj>& group = groups[ns];
+            group.push_back(*it);
+            if (group.size() == groupSize) {
+                prefetcherPool.schedule(&prefetchOpGroup, group);
+                group.clear();
+            }
+        }
+        for (map<string, std::vector<BSONObj> >::const_iterator it = groups.begin();
+             it != groups.end();
+             ++it) {
+            if (!it->second.empty()) {
+                prefetcherPool.schedule(&prefetchOpGroup, it->second);
+            }
         }
         prefetcherPool.join();
     }
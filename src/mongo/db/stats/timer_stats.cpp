@@ -37,9 +37,9 @@ namespace mongo {
         return _t.millis();
     }
 
-    void TimerStats::recordMillis( int millis ) {
+    void TimerStats::recordMillis( int millis, long long count ) {
         scoped_spinlock lk( _lock );
-        _num++;
+        _num += count;
         _totalMillis += millis;
     }
 
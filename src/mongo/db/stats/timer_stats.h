@@ -31,7 +31,8 @@ namespace mongo {
      */
     class TimerStats {
     public:
-        void recordMillis( int millis );
+        /** 'count' operations which took 'millis' in total */
+        void recordMillis( int millis, long long count = 1 );
 
         /**
          * @return number of millis
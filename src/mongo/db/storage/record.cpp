@@ -26,6 +26,7 @@
 #include "mongo/db/database_holder.h"
 #include "mongo/db/pagefault.h"
 #include "mongo/db/pdfile.h"
+#include "mongo/db/storage/residency_tracker.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/util/net/listen.h"
@@ -438,6 +439,10 @@ namespace mongo {
         }
         
         ps::appendWorkingSetInfo( b );
+
+        BSONObjBuilder residency( b.subobjStart( "residency" ) );
+        ResidencyTracker::appendStats( residency );
+        residency.done();
     }
 
     bool Record::likelyInPhysicalMemory() const {
@@ -0,0 +1,274 @@
+// residency_tracker.cpp
+
+/**
+*    Copyright (C) 2013 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/pch.h"
+
+#include "mongo/db/storage/residency_tracker.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/durable_mapped_file.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+    MONGO_EXPORT_SERVER_PARAMETER( residencyTrackerEnabled, bool, false );
+    MONGO_EXPORT_SERVER_PARAMETER( residencySampleIntervalMillis, int, 1000 );
+
+    namespace {
+
+        /** residency of one mapped view, 1 bit per page */
+        struct FileResidency {
+            const char* start;
+            const char* end;
+            vector<unsigned long long> bits;
+
+            bool resident( size_t page ) const {
+                return bits[page / 64] & ( 1ULL << ( page % 64 ) );
+            }
+        };
+
+        bool startsBefore( const char* p, const FileResidency& f ) {
+            return p < f.start;
+        }
+
+        /** immutable once published */
+        struct Snapshot {
+            Snapshot() : pageShift( 0 ), pagesTotal( 0 ), pagesResident( 0 ),
+                         sampledAt( 0 ), sampleMicros( 0 ) { }
+
+            vector<FileResidency> files; // sorted by start
+            int pageShift;
+            unsigned long long pagesTotal;
+            unsigned long long pagesResident;
+            unsigned long long sampledAt; // millis
+            long long sampleMicros;
+        };
+
+        SpinLock snapshotLock;
+        shared_ptr<const Snapshot> currentSnapshot;
+
+        // lets check() skip the lock while nothing is published, i.e. while tracking is off
+        AtomicUInt32 haveSnapshot;
+
+        shared_ptr<const Snapshot> getSnapshot() {
+            scoped_spinlock lk( snapshotLock );
+            return currentSnapshot;
+        }
+
+        void setSnapshot( const shared_ptr<const Snapshot>& s ) {
+            scoped_spinlock lk( snapshotLock );
+            currentSnapshot = s;
+            haveSnapshot.store( s ? 1 : 0 );
+        }
+
+        // pages passed to mincore() at a time, the mmfiles lock is only held for one of these
+        const size_t PagesPerChunk = 16 * 1024;
+
+        struct View {
+            const char* start;
+            size_t numPages;
+        };
+
+        /** called from MongoFile::forEach, under the mmfiles lock */
+        class ListViews {
+        public:
+            ListViews( int pageShift, vector<View>* views )
+                : _pageShift( pageShift ), _views( views ) { }
+
+            void operator()( MongoFile* mf ) {
+                if ( ! mf->isDurableMappedFile() )
+                    return;
+
+                DurableMappedFile* mmf = (DurableMappedFile*) mf;
+                const char* view = static_cast<const char*>( mmf->getView() );
+                if ( ! view )
+                    return; // not fully opened yet
+
+                const size_t pageSize = 1 << _pageShift;
+                View v;
+                v.start = view;
+                v.numPages = ( mmf->length() + pageSize - 1 ) / pageSize;
+                if ( v.numPages )
+                    _views->push_back( v );
+            }
+
+        private:
+            int _pageShift;
+            vector<View>* _views;
+        };
+
+        int getPageShift() {
+            int pageShift = 0;
+            while ( ( 1ULL << pageShift ) < ProcessInfo::getPageSize() )
+                pageShift++;
+            return pageShift;
+        }
+
+        bool lessByStart( const FileResidency& a, const FileResidency& b ) {
+            return a.start < b.start;
+        }
+
+        SimpleMutex sampleMutex( "ResidencyTracker::sample" );
+        vector<char> sampleScratch; // guarded by sampleMutex, at most PagesPerChunk long
+
+        /**
+         * Fills in f from mincore() a chunk at a time, taking the mmfiles lock for each chunk.
+         * Returns false if files were opened or closed meanwhile, as the view may be gone.
+         */
+        bool sampleView( const View& v, unsigned era, Snapshot* s, FileResidency* f ) {
+            const size_t pageSize = 1 << s->pageShift;
+            f->start = v.start;
+            f->end = v.start + v.numPages * pageSize;
+            f->bits.resize( ( v.numPages + 63 ) / 64, 0 );
+
+            unsigned long long resident = 0;
+            for ( size_t first = 0; first < v.numPages; first += PagesPerChunk ) {
+                const size_t n = std::min( PagesPerChunk, v.numPages - first );
+
+                LockMongoFilesShared lk;
+                if ( LockMongoFilesShared::getEra() != era )
+                    return false;
+                if ( ! ProcessInfo::pagesInMemory( v.start + first * pageSize, n, &sampleScratch ) )
+                    return false;
+
+                for ( size_t i = 0; i < n; i++ ) {
+                    if ( sampleScratch[i] ) {
+                        const size_t page = first + i;
+                        f->bits[page / 64] |= 1ULL << ( page % 64 );
+                        resident++;
+                    }
+                }
+            }
+
+            s->pagesTotal += v.numPages;
+            s->pagesResident += resident;
+            return true;
+        }
+
+        class ResidencySampler : public BackgroundJob {
+        public:
+            virtual string name() const { return "ResidencySampler"; }
+
+            virtual void run() {
+                Client::initThread( name().c_str() );
+
+                while ( ! inShutdown() ) {
+                    sleepmillis( std::max( 10, static_cast<int>( residencySampleIntervalMillis ) ) );
+
+                    if ( ! residencyTrackerEnabled ) {
+                        ResidencyTracker::reset();
+                        continue;
+                    }
+
+                    ResidencyTracker::sample();
+                }
+
+                cc().shutdown();
+            }
+        };
+
+    }
+
+    void ResidencyTracker::sample() {
+        SimpleMutex::scoped_lock lk( sampleMutex );
+
+        Timer t;
+        shared_ptr<Snapshot> s( new Snapshot() );
+        s->pageShift = getPageShift();
+
+        vector<View> views;
+        unsigned era;
+        {
+            LockMongoFilesShared lk;
+            era = LockMongoFilesShared::getEra();
+            MongoFile::forEach( ListViews( s->pageShift, &views ) );
+        }
+
+        // If files come or go part way through, publish the ones sampled so far.  The next
+        // sample starts over anyway.
+        for ( size_t i = 0; i < views.size(); i++ ) {
+            s->files.push_back( FileResidency() );
+            if ( ! sampleView( views[i], era, s.get(), &s->files.back() ) ) {
+                s->files.pop_back();
+                break;
+            }
+        }
+
+        std::sort( s->files.begin(), s->files.end(), lessByStart );
+        s->sampledAt = curTimeMillis64();
+        s->sampleMicros = t.micros();
+        setSnapshot( s );
+    }
+
+    void ResidencyTracker::reset() {
+        setSnapshot( shared_ptr<const Snapshot>() );
+    }
+
+    ResidencyTracker::Answer ResidencyTracker::check( const void* ptr ) {
+        if ( ! haveSnapshot.load() )
+            return Unknown;
+
+        shared_ptr<const Snapshot> s = getSnapshot();
+        if ( ! s )
+            return Unknown;
+
+        const char* p = static_cast<const char*>( ptr );
+        vector<FileResidency>::const_iterator i =
+            std::upper_bound( s->files.begin(), s->files.end(), p, startsBefore );
+        if ( i == s->files.begin() )
+            return Unknown;
+        --i;
+        if ( p >= i->end )
+            return Unknown;
+
+        return i->resident( static_cast<size_t>( p - i->start ) >> s->pageShift ) ?
+            Resident : NotResident;
+    }
+
+    void ResidencyTracker::appendStats( BSONObjBuilder& b ) {
+        shared_ptr<const Snapshot> s = getSnapshot();
+        if ( ! s ) {
+            b.append( "enabled", false );
+            return;
+        }
+
+        b.append( "enabled", true );
+        b.appendNumber( "files", static_cast<long long>( s->files.size() ) );
+        b.appendNumber( "pagesSampled", static_cast<long long>( s->pagesTotal ) );
+        b.appendNumber( "pagesResident", static_cast<long long>( s->pagesResident ) );
+        b.appendNumber( "sampleTimeMicros", s->sampleMicros );
+        b.appendNumber( "ageMillis", static_cast<long long>( curTimeMillis64() - s->sampledAt ) );
+    }
+
+    void startResidencyTracker() {
+        if ( ! ProcessInfo::blockCheckSupported() ) {
+            LOG(1) << "page residency checks not supported, not starting ResidencySampler" << endl;
+            return;
+        }
+
+        ResidencySampler* sampler = new ResidencySampler();
+        sampler->go();
+    }
+
+}
@@ -0,0 +1,61 @@
+// residency_tracker.h
+
+/**
+*    Copyright (C) 2013 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+    /**
+     * Keeps a recent picture of which pages of our data files are in physical memory.
+     *
+     * When residencyTrackerEnabled is set, a background thread samples mincore() for the private
+     * view of every DurableMappedFile and publishes one bitmap per file (1 bit per page).  The
+     * files are read a chunk at a time, so the mmfiles lock is never held for a whole pass.  A
+     * lookup is a binary search over the mapped views plus a bit test.
+     *
+     * The bitmaps are only as fresh as the last sample: a page may have been evicted or faulted
+     * in since, so the answer is a hint and never a guarantee.  That is why
+     * Record::likelyInPhysicalMemory keeps to its exact system call; the samples are reported
+     * under serverStatus.workingSet.residency.
+     */
+    class ResidencyTracker {
+    public:
+        enum Answer {
+            Resident,
+            NotResident,
+            Unknown // pointer is not in a sampled view, or tracking is off
+        };
+
+        /** threadsafe, does not block on the sampler; only reads a flag while tracking is off */
+        static Answer check( const void* ptr );
+
+        /** samples every mapped file now and publishes the result, as the sampler thread does */
+        static void sample();
+
+        /** drops the current sample, check() answers Unknown until the next one */
+        static void reset();
+
+        static void appendStats( BSONObjBuilder& b );
+    };
+
+    /** starts the sampler thread; a no-op if the platform can't check page residency */
+    void startResidencyTracker();
+
+}
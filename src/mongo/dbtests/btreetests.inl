@@ -285,6 +285,32 @@
         }
     };
 
+    /** keys whose leading fields repeat, so the search can skip comparing them */
+    class SharedPrefixLocate : public Base {
+    public:
+        void run() {
+            for ( int p = 0; p < 3; ++p ) {
+                for ( int i = 0; i < 100; i += 2 ) {
+                    BSONObj k = key( p, i );
+                    insert( k );
+                }
+            }
+            checkValid( 150 );
+
+            for ( int p = 0; p < 3; ++p ) {
+                for ( int i = 0; i < 100; ++i ) {
+                    BSONObj k = key( p, i );
+                    ASSERT_EQUALS( i % 2 == 0, present( k, 1 ) );
+                    ASSERT_EQUALS( i % 2 == 0, present( k, -1 ) );
+                }
+            }
+        }
+    private:
+        BSONObj key( int p, int i ) {
+            return BSON( "a" << bigNumString( p, 100 ) << "b" << bigNumString( p, 50 ) << "c" << i );
+        }
+    };
+
     class DontReuseUnused : public Base {
     public:
         void run() {
@@ -1640,6 +1666,7 @@
             add< MissingLocate >();
             add< MissingLocateMultiBucket >();
             add< SERVER983 >();
+            add< SharedPrefixLocate >();
             add< DontReuseUnused >();
             add< PackUnused >();
             add< DontDropReferenceKey >();
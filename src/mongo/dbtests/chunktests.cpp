@@ -32,6 +32,7 @@ namespace mongo {
         void setSingleChunkForShards( const vector<BSONObj> &splitPoints ) {
             ChunkMap &chunkMap = const_cast<ChunkMap&>( _chunkMap );
             ChunkRangeManager &chunkRanges = const_cast<ChunkRangeManager&>( _chunkRanges );
+            ChunkRoutingTable &routingTable = const_cast<ChunkRoutingTable&>( _routingTable );
             set<Shard> &shards = const_cast<set<Shard>&>( _shards );
             
             vector<BSONObj> mySplitPoints( splitPoints );
@@ -49,6 +50,7 @@ namespace mongo {
             }
             
             chunkRanges.reloadAll( chunkMap );
+            routingTable.reloadAll( chunkMap );
         }
     };
     
@@ -235,6 +237,33 @@ namespace ChunkTests {
             }
         };
 
+        /** Keys are routed to the chunk with min <= key < max. */
+        class FindIntersectingChunk {
+        public:
+            void run() {
+                ChunkManager chunkManager;
+                chunkManager.setShardKey( BSON( "a" << 1 ) );
+                vector<BSONObj> splitPoints;
+                splitPoints.push_back( BSON( "a" << "x" ) );
+                splitPoints.push_back( BSON( "a" << "y" ) );
+                splitPoints.push_back( BSON( "a" << "z" ) );
+                chunkManager.setSingleChunkForShards( splitPoints );
+
+                ASSERT_EQUALS( "0", shardFor( chunkManager, BSON( "a" << MINKEY ) ) );
+                ASSERT_EQUALS( "0", shardFor( chunkManager, BSON( "a" << 5 ) ) );
+                ASSERT_EQUALS( "0", shardFor( chunkManager, BSON( "a" << "w" ) ) );
+                ASSERT_EQUALS( "1", shardFor( chunkManager, BSON( "a" << "x" ) ) );
+                ASSERT_EQUALS( "1", shardFor( chunkManager, BSON( "a" << "xx" ) ) );
+                ASSERT_EQUALS( "2", shardFor( chunkManager, BSON( "a" << "y" ) ) );
+                ASSERT_EQUALS( "3", shardFor( chunkManager, BSON( "a" << "z" ) ) );
+                ASSERT_EQUALS( "3", shardFor( chunkManager, BSON( "a" << OID() ) ) );
+            }
+        private:
+            string shardFor( const ChunkManager& chunkManager, const BSONObj& key ) {
+                return chunkManager.findIntersectingChunk( key )->getShard().getName();
+            }
+        };
+
     } // namespace ChunkManagerTests
     
     class All : public Suite {
@@ -263,6 +292,7 @@ namespace ChunkTests {
             add<ChunkManagerTests::InequalityThenUnsatisfiable>();
             add<ChunkManagerTests::OrEqualityUnsatisfiableInequality>();
             add<ChunkManagerTests::InMultiShard>();
+            add<ChunkManagerTests::FindIntersectingChunk>();
         }
     } myall;
     
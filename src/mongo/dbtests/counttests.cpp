@@ -137,6 +137,30 @@ namespace CountTests {
         }
     };
 
+    /** A range spanning many btree buckets, with skip and limit falling inside buckets. */
+    class IndexedRange : public Base {
+    public:
+        void run() {
+            for( int i = 0; i < 5000; ++i ) {
+                insert( BSON( "a" << i ) );
+            }
+            BSONObj query = BSON( "a" << GTE << 100 << LT << 4900 );
+            ASSERT_EQUALS( 4800, count( BSON( "query" << query ) ) );
+            ASSERT_EQUALS( 4750, count( BSON( "query" << query << "skip" << 50 ) ) );
+            ASSERT_EQUALS( 1000, count( BSON( "query" << query << "limit" << 1000 ) ) );
+            ASSERT_EQUALS( 10, count( BSON( "query" << query << "skip" << 4790 <<
+                                            "limit" << 100 ) ) );
+            ASSERT_EQUALS( 0, count( BSON( "query" << query << "skip" << 5000 ) ) );
+            ASSERT_EQUALS( 1, count( BSON( "query" << BSON( "a" << 2500 ) ) ) );
+        }
+    private:
+        static long long count( const BSONObj& cmd ) {
+            string err;
+            int errCode;
+            return runCount( ns(), cmd, err, errCode );
+        }
+    };
+
     /** Set a value or await an expected value. */
     class PendingValue {
     public:
@@ -242,6 +266,7 @@ namespace CountTests {
             add<Fields>();
             add<QueryFields>();
             add<IndexedRegex>();
+            add<IndexedRange>();
             add<Yield>();
         }
     } myall;
@@ -878,6 +878,68 @@ namespace DocumentSourceTests {
             string expectedResultSetString() { return "[{_id:[1,2,3],a:[[4,5,6]]}]"; }
         };
 
+        /** A $group whose cursor has the group's dependencies reads the cursor's columns. */
+        class ColumnarBase : public CheckResultsBase {
+        public:
+            void run() {
+                populateData();
+                createSource();
+                createGroup( groupSpec() );
+
+                set<string> deps;
+                ASSERT_EQUALS( mongo::DocumentSource::EXHAUSTIVE,
+                               group()->getDependencies( deps ) );
+                source()->setProjection( mongo::DocumentSource::depsToProjection( deps ),
+                                         mongo::DocumentSource::parseDeps( deps ) );
+                ASSERT( source()->producesBatches() );
+
+                checkResultSet( group() );
+            }
+        };
+
+        /** Top-level fields are used straight from their columns. */
+        class ColumnarFields : public ColumnarBase {
+            void populateData() {
+                client.insert( ns, BSON( "a" << 1 << "b" << 1 << "c" << "x" ) );
+                client.insert( ns, BSON( "a" << 1 << "b" << 2 ) );
+                client.insert( ns, BSON( "a" << 2 << "b" << 3 ) );
+                client.insert( ns, BSON( "a" << 1 << "b" << 4.5 ) );
+                client.insert( ns, BSON( "b" << 5 ) );
+            }
+            BSONObj groupSpec() {
+                return fromjson( "{_id:'$a',s:{$sum:'$b'},n:{$sum:1},l:{$last:'$b'}}" );
+            }
+            string expectedResultSetString() {
+                return "[{_id:null,s:5,n:1,l:5},{_id:1,s:7.5,n:3,l:4.5},{_id:2,s:3,n:1,l:3}]";
+            }
+        };
+
+        /** Dotted field paths are evaluated from the column of their top-level field. */
+        class ColumnarNestedFields : public ColumnarBase {
+            void populateData() {
+                client.insert( ns, fromjson( "{a:{x:1,y:1},b:[{c:1},{c:2}]}" ) );
+                client.insert( ns, fromjson( "{a:{x:1},b:[{c:3}]}" ) );
+                client.insert( ns, fromjson( "{a:{x:2}}" ) );
+            }
+            BSONObj groupSpec() { return fromjson( "{_id:'$a.x',p:{$push:'$b.c'}}" ); }
+            string expectedResultSetString() { return "[{_id:1,p:[[1,2],[3]]},{_id:2,p:[]}]"; }
+        };
+
+        /** Other expressions are evaluated on documents built from the columns. */
+        class ColumnarExpressions : public ColumnarBase {
+            void populateData() {
+                client.insert( ns, BSON( "a" << 1 << "b" << 2 ) );
+                client.insert( ns, BSON( "a" << 2 << "b" << 1 ) );
+                client.insert( ns, BSON( "a" << 5 << "b" << 5 ) );
+            }
+            BSONObj groupSpec() {
+                return fromjson( "{_id:{$add:['$a','$b']},o:{$push:{a:'$a',b:'$b'}}}" );
+            }
+            string expectedResultSetString() {
+                return "[{_id:3,o:[{a:1,b:2},{a:2,b:1}]},{_id:10,o:[{a:5,b:5}]}]";
+            }
+        };
+
     } // namespace DocumentSourceGroup
 
     namespace DocumentSourceProject {
@@ -1071,7 +1133,7 @@ namespace DocumentSourceTests {
                     sort()->addToBsonArray(&arr, false);
                     ASSERT_EQUALS(arr.arr(), BSON_ARRAY(BSON("$sort" << BSON("a" << 1))));
 
-                    ASSERT(sort()->getShardSource() == NULL);
+                    ASSERT(sort()->getShardSource() != NULL);
                     ASSERT(sort()->getRouterSource() != NULL);
                 }
 
@@ -1098,6 +1160,57 @@ namespace DocumentSourceTests {
             }
         };
 
+        /** The router half of a split $sort merges the presorted shard outputs. */
+        class MergePresorted : public Base {
+        public:
+            void run() {
+                createSort(BSON("a" << 1));
+                intrusive_ptr<DocumentSourceSort> merger =
+                    dynamic_cast<DocumentSourceSort*>(sort()->getRouterSource().get());
+                ASSERT(merger);
+                ASSERT(merger != sort());
+                ASSERT(merger->isMergingPresorted());
+                ASSERT(!sort()->isMergingPresorted());
+
+                BSONArrayBuilder arr;
+                merger->addToBsonArray(&arr, false);
+                BSONObj spec = arr.arr()[0].Obj().getOwned();
+                ASSERT_EQUALS(spec, BSON("$sort" << BSON("a" << 1 << "$mergePresorted" << true)));
+
+                // survives the trip to the merging shard
+                BSONElement specElement = spec.firstElement();
+                intrusive_ptr<DocumentSource> reparsed =
+                    DocumentSourceSort::createFromBson(&specElement, ctx());
+                ASSERT(static_cast<DocumentSourceSort*>(reparsed.get())->isMergingPresorted());
+            }
+        };
+
+        /** Sorted shard results are merged rather than resorted. */
+        class MergePresortedFromShards : public Base {
+        public:
+            void run() {
+                createSort(BSON("a" << -1));
+                intrusive_ptr<DocumentSource> merger = sort()->getRouterSource();
+
+                DocumentSourceCommandShards::ShardOutput shardOutput(2);
+                shardOutput[0].result = BSON("ok" << 1 << "result"
+                                             << BSON_ARRAY(BSON("a" << 5) << BSON("a" << 2)));
+                shardOutput[1].result = BSON("ok" << 1 << "result"
+                                             << BSON_ARRAY(BSON("a" << 4) << BSON("a" << 3)
+                                                                          << BSON("a" << 1)));
+                intrusive_ptr<DocumentSource> shards =
+                    DocumentSourceCommandShards::create(shardOutput, ctx());
+                merger->setSource(shards.get());
+
+                for (int i = 5; i >= 1; i--) {
+                    boost::optional<Document> next = merger->getNext();
+                    ASSERT(next);
+                    ASSERT_EQUALS(next->toBson(), BSON("a" << i));
+                }
+                ASSERT(!merger->getNext());
+            }
+        };
+
         class CheckResultsBase : public Base {
         public:
             virtual ~CheckResultsBase() {}
@@ -1216,6 +1329,16 @@ namespace DocumentSourceTests {
             BSONObj sortSpec() { return BSON( "a" << 0 ); }
         };
 
+        /** $mergePresorted is only ever generated as true. */
+        class FalseMergePresortedSpec : public InvalidSpecBase {
+            BSONObj sortSpec() { return BSON( "a" << 1 << "$mergePresorted" << false ); }
+        };
+
+        /** $mergePresorted must be a bool. */
+        class NonBoolMergePresortedSpec : public InvalidSpecBase {
+            BSONObj sortSpec() { return BSON( "a" << 1 << "$mergePresorted" << 1 ); }
+        };
+
         /** Sort spec with a descending field. */
         class DescendingOrder : public CheckResultsBase {
             void populateData() {
@@ -1695,6 +1818,9 @@ namespace DocumentSourceTests {
             add<DocumentSourceGroup::Dependencies>();
             add<DocumentSourceGroup::StringConstantIdAndAccumulatorExpressions>();
             add<DocumentSourceGroup::ArrayConstantAccumulatorExpression>();
+            add<DocumentSourceGroup::ColumnarFields>();
+            add<DocumentSourceGroup::ColumnarNestedFields>();
+            add<DocumentSourceGroup::ColumnarExpressions>();
 
             add<DocumentSourceProject::Inclusion>();
             add<DocumentSourceProject::Optimize>();
@@ -1712,6 +1838,8 @@ namespace DocumentSourceTests {
             add<DocumentSourceSort::EmptyObjectSpec>();
             add<DocumentSourceSort::NonNumberDirectionSpec>();
             add<DocumentSourceSort::InvalidNumberDirectionSpec>();
+            add<DocumentSourceSort::FalseMergePresortedSpec>();
+            add<DocumentSourceSort::NonBoolMergePresortedSpec>();
             add<DocumentSourceSort::DescendingOrder>();
             add<DocumentSourceSort::DottedSortField>();
             add<DocumentSourceSort::CompoundSortSpec>();
@@ -1724,6 +1852,8 @@ namespace DocumentSourceTests {
             add<DocumentSourceSort::MissingObjectWithinArray>();
             add<DocumentSourceSort::ExtractArrayValues>();
             add<DocumentSourceSort::Dependencies>();
+            add<DocumentSourceSort::MergePresorted>();
+            add<DocumentSourceSort::MergePresortedFromShards>();
 
             add<DocumentSourceUnwind::Empty>();
             add<DocumentSourceUnwind::MissingField>();
@@ -316,6 +316,96 @@ namespace DocumentTests {
             }
         };
 
+        /** A lazy Document converts fields on demand but behaves like a converted one. */
+        class LazyFromBson {
+        public:
+            void run() {
+                BSONObjBuilder bob;
+                for ( int i = 0; i < 10; ++i ) {
+                    bob.append( string( 1, 'a' + i ), i );
+                }
+                bob.append( "sub", BSON( "x" << 1 << "y" << BSON_ARRAY( 1 << 2 ) ) );
+                BSONObj obj = bob.obj();
+
+                Document document = Document::lazyFromBson( obj );
+                ASSERT( !document.empty() );
+                ASSERT_EQUALS( 2, document[ "c" ].getInt() );
+                ASSERT( document[ "missing" ].missing() );
+                // fields before the last one converted are still found
+                ASSERT_EQUALS( 1, document[ "b" ].getInt() );
+                ASSERT( obj.binaryEqual( toBson( document ) ) );
+                ASSERT_EQUALS( 11U, document.size() );
+                ASSERT_EQUALS( fromBson( obj ), document );
+
+                // Positions stay valid after the rest of the document is converted.
+                Document other = Document::lazyFromBson( obj );
+                Position position = other.positionOf( "d" );
+                ASSERT( position.found() );
+                MutableDocument md( other );
+                ASSERT_EQUALS( 3, md.peek()[ position ].getInt() );
+                md.getField( position ) = mongo::Value( 33 );
+                md.addField( "new", mongo::Value( 5 ) );
+                Document modified = md.freeze();
+                ASSERT_EQUALS( 33, modified[ "d" ].getInt() );
+                ASSERT_EQUALS( 12U, modified.size() );
+                ASSERT_EQUALS( 5, toBson( modified )[ "new" ].numberInt() );
+                ASSERT_EQUALS( 3, other[ "d" ].getInt() );
+                ASSERT( obj.binaryEqual( toBson( other ) ) );
+
+                // A Document that isn't shared is modified in place.
+                MutableDocument inPlace( Document::lazyFromBson( obj ) );
+                inPlace[ "a" ] = mongo::Value( 100 );
+                BSONObj inPlaceBson = toBson( inPlace.freeze() );
+                ASSERT_EQUALS( 100, inPlaceBson[ "a" ].numberInt() );
+                ASSERT_EQUALS( 11, inPlaceBson.nFields() );
+
+                ASSERT( Document::lazyFromBson( BSONObj() ).empty() );
+            }
+        };
+
+        /** Build a DocumentBatch by column and materialize its documents. */
+        class Batch {
+        public:
+            void run() {
+                vector<string> fieldNames;
+                fieldNames.push_back( "a" );
+                fieldNames.push_back( "b" );
+
+                DocumentBatch batch;
+                batch.reset( fieldNames );
+                ASSERT( batch.empty() );
+                ASSERT_EQUALS( 2U, batch.numColumns() );
+                ASSERT_EQUALS( 0, batch.findColumn( "a" ) );
+                ASSERT_EQUALS( 1, batch.findColumn( "b" ) );
+                ASSERT_EQUALS( -1, batch.findColumn( "c" ) );
+
+                ASSERT_EQUALS( 0U, batch.addDocument() );
+                batch.setField( 0, 1, mongo::Value( 2 ) );
+                batch.setField( 0, 0, mongo::Value( 1 ) );
+                ASSERT_EQUALS( 1U, batch.addDocument() );
+                batch.setField( 1, 1, mongo::Value( "x" ) );
+                ASSERT_EQUALS( 2U, batch.size() );
+
+                ASSERT_EQUALS( 1, batch.getColumn( 0 )[ 0 ].getInt() );
+                ASSERT( batch.getColumn( 0 )[ 1 ].missing() );
+
+                // fields come back in column order and missing fields are left out
+                ASSERT_EQUALS( BSON( "a" << 1 << "b" << 2 ), toBson( batch.getDocument( 0 ) ) );
+                ASSERT_EQUALS( BSON( "b" << "x" ), toBson( batch.getDocument( 1 ) ) );
+
+                // resetting with the same columns empties them
+                batch.reset( fieldNames );
+                ASSERT( batch.empty() );
+                ASSERT( batch.getColumn( 1 ).empty() );
+
+                // resetting with different columns replaces them
+                fieldNames.pop_back();
+                batch.reset( fieldNames );
+                ASSERT_EQUALS( 1U, batch.numColumns() );
+                ASSERT_EQUALS( -1, batch.findColumn( "b" ) );
+            }
+        };
+
         class AllTypesDoc {
         public:
             void run() {
@@ -1391,6 +1481,8 @@ namespace DocumentTests {
             add<Document::FieldIteratorEmpty>();
             add<Document::FieldIteratorSingle>();
             add<Document::FieldIteratorMultiple>();
+            add<Document::LazyFromBson>();
+            add<Document::Batch>();
             add<Document::AllTypesDoc>();
 
             add<Value::Int>();
@@ -860,6 +860,150 @@ namespace ExpressionTests {
         
     } // namespace Compare
     
+    namespace CompiledArithmetic {
+
+        /**
+         * Checks that an optimized arithmetic expression is compiled and evaluates to exactly the
+         * same value as the original tree.
+         */
+        class ExpectedResultBase {
+        public:
+            virtual ~ExpectedResultBase() {
+            }
+            void run() {
+                BSONObj specObject = BSON( "" << spec() );
+                BSONElement specElement = specObject.firstElement();
+                intrusive_ptr<Expression> expression = Expression::parseOperand( &specElement );
+                Value expected = expression->evaluate( fromBson( document() ) );
+                intrusive_ptr<Expression> optimized = expression->optimize();
+                ASSERT_EQUALS( compiled(),
+                               (bool)dynamic_pointer_cast<ExpressionCompiledArithmetic>( optimized ) );
+                assertBinaryEqual( toBson( expected ),
+                                   toBson( optimized->evaluate( fromBson( document() ) ) ) );
+                assertBinaryEqual( BSON( "" << expectedResult() ), toBson( expected ) );
+            }
+        protected:
+            virtual BSONObj spec() = 0;
+            virtual BSONObj document() = 0;
+            virtual BSONObj expectedResult() = 0;
+            virtual bool compiled() { return true; }
+        };
+
+        /** Two ints are added as an int. */
+        class AddInts : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$add" << BSON_ARRAY( "$a" << "$b" ) ); }
+            BSONObj document() { return BSON( "a" << 1 << "b" << 2 ); }
+            BSONObj expectedResult() { return BSON( "" << 3 ); }
+        };
+
+        /** An int sum that overflows is widened to a long. */
+        class AddIntOverflow : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$add" << BSON_ARRAY( "$a" << 1 ) ); }
+            BSONObj document() { return BSON( "a" << numeric_limits<int>::max() ); }
+            BSONObj expectedResult() {
+                return BSON( "" << numeric_limits<int>::max() + 1LL );
+            }
+        };
+
+        /** A double operand makes the result a double. */
+        class AddDouble : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$add" << BSON_ARRAY( "$a" << "$b" << 1 ) ); }
+            BSONObj document() { return BSON( "a" << 1 << "b" << 0.5 ); }
+            BSONObj expectedResult() { return BSON( "" << 2.5 ); }
+        };
+
+        /** Nested operators are compiled into a single program. */
+        class Nested : public ExpectedResultBase {
+            BSONObj spec() {
+                return fromjson( "{$subtract:[{$add:['$a',{$multiply:['$b',2]}]},"
+                                 "{$divide:['$c',4]}]}" );
+            }
+            BSONObj document() { return BSON( "a" << 1 << "b" << 3LL << "c" << 10 ); }
+            BSONObj expectedResult() { return BSON( "" << 4.5 ); }
+        };
+
+        /** A long product keeps its type. */
+        class MultiplyLong : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$multiply" << BSON_ARRAY( "$a" << "$b" ) ); }
+            BSONObj document() { return BSON( "a" << 3 << "b" << 4LL ); }
+            BSONObj expectedResult() { return BSON( "" << 12LL ); }
+        };
+
+        /** A missing field falls back to the original tree, which returns null. */
+        class MissingField : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$add" << BSON_ARRAY( "$a" << "$b" ) ); }
+            BSONObj document() { return BSON( "a" << 1 ); }
+            BSONObj expectedResult() { return BSON( "" << BSONNULL ); }
+        };
+
+        /** A Date field falls back to the original tree. */
+        class AddDate : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$add" << BSON_ARRAY( "$a" << 1000 ) ); }
+            BSONObj document() { return BSON( "a" << Date_t( 5000 ) ); }
+            BSONObj expectedResult() { return BSON( "" << Date_t( 6000 ) ); }
+        };
+
+        /** Subtracting dates falls back to the original tree. */
+        class SubtractDates : public ExpectedResultBase {
+            BSONObj spec() { return BSON( "$subtract" << BSON_ARRAY( "$a" << "$b" ) ); }
+            BSONObj document() { return BSON( "a" << Date_t( 5000 ) << "b" << Date_t( 2000 ) ); }
+            BSONObj expectedResult() { return BSON( "" << 3000LL ); }
+        };
+
+        /** An operator that isn't arithmetic isn't compiled. */
+        class NotCompiled : public ExpectedResultBase {
+            BSONObj spec() {
+                return fromjson( "{$add:['$a',{$strcasecmp:['x','$b']}]}" );
+            }
+            BSONObj document() { return BSON( "a" << 1 << "b" << "x" ); }
+            BSONObj expectedResult() { return BSON( "" << 1 ); }
+            bool compiled() { return false; }
+        };
+
+        /** Dividing by zero raises the same error as the original tree. */
+        class DivideByZero {
+        public:
+            void run() {
+                BSONObj specObject = BSON( "" << BSON( "$divide" << BSON_ARRAY( "$a" << "$b" ) ) );
+                BSONElement specElement = specObject.firstElement();
+                intrusive_ptr<Expression> optimized =
+                        Expression::parseOperand( &specElement )->optimize();
+                ASSERT( dynamic_pointer_cast<ExpressionCompiledArithmetic>( optimized ) );
+                ASSERT_THROWS( optimized->evaluate( fromBson( BSON( "a" << 1 << "b" << 0 ) ) ),
+                               UserException );
+            }
+        };
+
+        /** A compiled expression serializes as the tree it was compiled from. */
+        class Serialize {
+        public:
+            void run() {
+                BSONObj spec = fromjson( "{$add:['$a',{$multiply:['$b',2]}]}" );
+                BSONObj specObject = BSON( "" << spec );
+                BSONElement specElement = specObject.firstElement();
+                intrusive_ptr<Expression> optimized =
+                        Expression::parseOperand( &specElement )->optimize();
+                ASSERT( dynamic_pointer_cast<ExpressionCompiledArithmetic>( optimized ) );
+                ASSERT_EQUALS( constify( spec ), expressionToBson( optimized ) );
+            }
+        };
+
+        /** Compiled operands don't stop the constants of an $add from being folded. */
+        class Flatten {
+        public:
+            void run() {
+                BSONObj specObject =
+                        BSON( "" << fromjson( "{$add:[1,{$add:['$a',2]},3]}" ) );
+                BSONElement specElement = specObject.firstElement();
+                intrusive_ptr<Expression> optimized =
+                        Expression::parseOperand( &specElement )->optimize();
+                ASSERT_EQUALS( constify( fromjson( "{$add:['$a',6]}" ) ),
+                               expressionToBson( optimized ) );
+            }
+        };
+
+    } // namespace CompiledArithmetic
+
     namespace Constant {
 
         /** Create an ExpressionConstant from a Value. */
@@ -3621,6 +3765,19 @@ namespace ExpressionTests {
             add<Compare::OptimizeGte>();
             add<Compare::OptimizeGteReverse>();
 
+            add<CompiledArithmetic::AddInts>();
+            add<CompiledArithmetic::AddIntOverflow>();
+            add<CompiledArithmetic::AddDouble>();
+            add<CompiledArithmetic::Nested>();
+            add<CompiledArithmetic::MultiplyLong>();
+            add<CompiledArithmetic::MissingField>();
+            add<CompiledArithmetic::AddDate>();
+            add<CompiledArithmetic::SubtractDates>();
+            add<CompiledArithmetic::NotCompiled>();
+            add<CompiledArithmetic::DivideByZero>();
+            add<CompiledArithmetic::Serialize>();
+            add<CompiledArithmetic::Flatten>();
+
             add<Constant::Create>();
             add<Constant::CreateFromBsonElement>();
             add<Constant::Optimize>();
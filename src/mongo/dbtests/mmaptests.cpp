@@ -21,6 +21,8 @@
 #include <boost/filesystem/operations.hpp>
 
 #include "mongo/db/storage/durable_mapped_file.h"
+#include "mongo/db/storage/residency_tracker.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/timer.h"
 #include "mongo/dbtests/dbtests.h"
 
@@ -105,11 +107,72 @@ namespace MMapTests {
         }
     };
 
+    /** a page we just wrote is seen by a sample, memory outside the data files isn't tracked */
+    class ResidencyTest {
+        const string fn;
+        const int optOld;
+    public:
+        ResidencyTest() :
+            fn( (boost::filesystem::path(dbpath) / "residency.map").string() ),
+            optOld(cmdLine.durOptions)
+        {
+            cmdLine.durOptions = 0;
+        }
+        ~ResidencyTest() {
+            ResidencyTracker::reset();
+            cmdLine.durOptions = optOld;
+            try { boost::filesystem::remove(fn); }
+            catch(...) { }
+        }
+        void run() {
+            if ( ! ProcessInfo::blockCheckSupported() )
+                return;
+
+            try { boost::filesystem::remove(fn); }
+            catch(...) { }
+
+            Lock::GlobalWrite lk;
+
+            ResidencyTracker::reset();
+            int local = 0;
+            ASSERT_EQUALS( ResidencyTracker::Unknown, ResidencyTracker::check( &local ) );
+
+            DurableMappedFile f;
+            // larger than one mincore() chunk of the sampler
+            unsigned long long len = 128 * 1024 * 1024;
+            verify( f.create(fn, len, /*sequential*/false) );
+            char *p = (char *) f.getView();
+            verify(p);
+            if( cmdLine.dur )
+                MemoryMappedFile::makeWritable(p, len);
+            const size_t last = len - ProcessInfo::getPageSize();
+            strcpy(p, "hello");
+            strcpy(p + last, "world");
+
+            ResidencyTracker::sample();
+            ASSERT_EQUALS( ResidencyTracker::Resident, ResidencyTracker::check( p ) );
+            ASSERT_EQUALS( ResidencyTracker::Resident, ResidencyTracker::check( p + last ) );
+            ASSERT_EQUALS( ResidencyTracker::Unknown, ResidencyTracker::check( &local ) );
+
+            BSONObjBuilder b;
+            ResidencyTracker::appendStats( b );
+            BSONObj stats = b.obj();
+            ASSERT( stats["enabled"].trueValue() );
+            ASSERT( stats["pagesSampled"].numberLong() >=
+                    static_cast<long long>( len / ProcessInfo::getPageSize() ) );
+            ASSERT( stats["pagesResident"].numberLong() >= 2 );
+
+            ResidencyTracker::reset();
+            ASSERT_EQUALS( ResidencyTracker::Unknown, ResidencyTracker::check( p ) );
+        }
+    };
+
     class All : public Suite {
     public:
         All() : Suite( "mmap" ) {}
         void setupTests() {
             add< LeakTest >();
+            add< ResidencyTest >();
         }
     } myall;
 
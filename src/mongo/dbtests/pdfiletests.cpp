@@ -313,6 +313,41 @@ namespace PdfileTests {
                 ASSERT( 0 != o.getField( "a" ).date() );
             }
         };
+
+        /** Space reserved with BulkInsert::spaceFor() holds every record, added _ids included. */
+        class BulkInsertReservation : public Base {
+        public:
+            void run() {
+                BSONObj first = BSON( "x" << 0 );
+                theDataFileMgr.insertWithObjMod( ns(), first );
+                ASSERT( nsd()->haveIdIndex() );
+
+                vector<BSONObj> objs;
+                for ( int i = 1; i <= 100; i++ )
+                    objs.push_back( BSON( "x" << i << "s" << string( i * 7, 'a' ) ) );
+
+                int total = 0;
+                for ( size_t i = 0; i < objs.size(); i++ )
+                    total += BulkInsert::spaceFor( ns(), nsd(), objs[i] );
+
+                BulkInsert bulk( ns(), nsd() );
+                bulk.reserve( total );
+                for ( size_t i = 0; i < objs.size(); i++ ) {
+                    theDataFileMgr.insertWithObjMod( ns(), objs[i], false, false, &bulk );
+                    ASSERT( objs[i]["_id"].type() == jstOID );
+                }
+                bulk.finish();
+
+                // the records follow each other, none was allocated on its own
+                const vector<DiskLoc>& locs = bulk.insertedLocs();
+                ASSERT_EQUALS( objs.size(), locs.size() );
+                for ( size_t i = 1; i < locs.size(); i++ ) {
+                    ASSERT_EQUALS( locs[i - 1].a(), locs[i].a() );
+                    ASSERT_EQUALS( locs[i - 1].getOfs() + locs[i - 1].rec()->lengthWithHeaders(),
+                                   locs[i].getOfs() );
+                }
+            }
+        };
     } // namespace Insert
 
     class ExtentSizing {
@@ -390,6 +425,7 @@ namespace PdfileTests {
             add< ScanCapped::LastInExtent >();
             add< Insert::InsertAddId >();
             add< Insert::UpdateDate >();
+            add< Insert::BulkInsertReservation >();
             add< ExtentSizing >();
         }
     } myall;
@@ -1129,6 +1129,62 @@ namespace PerfTests {
         }
     };
 
+    /** updates a small working set of documents with one kind of modifier and reports how many
+        of the updates had to move their document, as a fraction of all updates
+    */
+    class UpdateMoves : public B {
+    public:
+        UpdateMoves() : _n( 0 ), _movesBefore( 0 ) { }
+        virtual int howLongMillis() { return 2000; }
+        virtual bool showDurStats() { return false; }
+        void prep() {
+            for( int i = 0; i < Docs; i++ )
+                client().insert( ns(), BSON( "_id" << i << "x" << 0 << "s" << "aaaaaaaa" << "arr" << BSONArray() ) );
+            _movesBefore = moves();
+        }
+        void timed() {
+            client().update( ns(), QUERY( "_id" << (int) ( _n % Docs ) ), mod() );
+            _n++;
+        }
+        void post() {
+            long long m = moves() - _movesBefore;
+            cout << "stats " << setw(42) << left << name() + " moves/update" << ' '
+                 << fixed << setprecision(4) << ( _n ? (double) m / _n : 0.0 ) << endl;
+        }
+    protected:
+        enum { Docs = 1000 };
+        unsigned long long _n;
+        virtual BSONObj mod() = 0;
+    private:
+        long long moves() {
+            BSONObj info;
+            client().runCommand( "admin", BSON( "serverStatus" << 1 ), info );
+            return info.getFieldDotted( "metrics.record.moves" ).numberLong();
+        }
+        long long _movesBefore;
+    };
+
+    class UpdateMovesInc : public UpdateMoves {
+        string name() { return "update-moves-inc"; }
+        BSONObj mod() { return BSON( "$inc" << BSON( "x" << 1 ) ); }
+    };
+
+    /** same size string, so the document never needs to grow */
+    class UpdateMovesSetString : public UpdateMoves {
+        string name() { return "update-moves-set-string"; }
+        BSONObj mod() {
+            char buf[9];
+            sprintf( buf, "%08u", (unsigned) ( _n & 0xffffff ) );
+            return BSON( "$set" << BSON( "s" << buf ) );
+        }
+    };
+
+    /** grows every document, so moves depend on padding */
+    class UpdateMovesPush : public UpdateMoves {
+        string name() { return "update-moves-push"; }
+        BSONObj mod() { return BSON( "$push" << BSON( "arr" << (int) _n ) ); }
+    };
+
     template <typename T>
     class MoreIndexes : public T {
     public:
@@ -1406,6 +1462,9 @@ namespace PerfTests {
                 add< MoreIndexes<InsertRandom> >();
                 add< Update1 >();
                 add< MoreIndexes<Update1> >();
+                add< UpdateMovesInc >();
+                add< UpdateMovesSetString >();
+                add< UpdateMovesPush >();
                 add< InsertBig >();
                 add< FailPointTest<false, false> >();
                 add< FailPointTest<true, false> >();
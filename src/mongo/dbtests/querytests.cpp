@@ -316,6 +316,58 @@ namespace QueryTests {
         }
     };
     
+    /**
+     * Dropping a collection kills the cursors open on it, and only those: cursors on another
+     * collection of the same database, including one whose name starts with the dropped one's,
+     * are left alone.
+     */
+    class DropKillsOnlyItsCursors : public ClientBase {
+    public:
+        DropKillsOnlyItsCursors() :
+            _a("unittests.querytests.DropKillsOnlyItsCursors"),
+            _b("unittests.querytests.DropKillsOnlyItsCursors2") {
+        }
+        ~DropKillsOnlyItsCursors() {
+            client().dropCollection( _a );
+            client().dropCollection( _b );
+        }
+        void run() {
+            for( int i = 0; i < 10; ++i ) {
+                insert( _a, BSON( "a" << i ) );
+                insert( _b, BSON( "a" << i ) );
+            }
+
+            auto_ptr<DBClientCursor> cursorA = client().query( _a, "", 0, 0, 0, 0, 2 );
+            auto_ptr<DBClientCursor> cursorB = client().query( _b, "", 0, 0, 0, 0, 2 );
+            CursorId idA = cursorA->getCursorId();
+            CursorId idB = cursorB->getCursorId();
+
+            set<CursorId> ids;
+            ClientCursor::find( _a, ids );
+            ASSERT_EQUALS( 1U, ids.size() );
+            ASSERT_EQUALS( 1U, ids.count( idA ) );
+
+            client().dropCollection( _a );
+
+            ids.clear();
+            ClientCursor::find( _a, ids );
+            ASSERT_EQUALS( 0U, ids.size() );
+            ids.clear();
+            ClientCursor::find( _b, ids );
+            ASSERT_EQUALS( 1U, ids.count( idB ) );
+
+            int count = 0;
+            while( cursorB->more() ) {
+                cursorB->next();
+                ++count;
+            }
+            ASSERT_EQUALS( 10, count );
+        }
+    private:
+        const char* _a;
+        const char* _b;
+    };
+
     class PositiveLimit : public ClientBase {
     public:
         const char* ns;
@@ -1670,6 +1722,7 @@ namespace QueryTests {
             add< GetMore >();
             add< GetMoreKillOp >();
             add< GetMoreInvalidRequest >();
+            add< DropKillsOnlyItsCursors >();
             add< PositiveLimit >();
             add< ReturnOneOfManyAndTail >();
             add< TailNotAtEnd >();
@@ -189,7 +189,9 @@ namespace mongo {
         }        
     }
 
-    void Balancer::_doBalanceRound( DBClientBase& conn, vector<CandidateChunkPtr>* candidateChunks ) {
+    void Balancer::_doBalanceRound( DBClientBase& conn,
+                                    vector<CandidateChunkPtr>* candidateChunks,
+                                    bool considerLoad ) {
         verify( candidateChunks );
 
         //
@@ -223,7 +225,8 @@ namespace mongo {
         //
         // 2. Get a list of all the shards that are participating in this balance round
         // along with any maximum allowed quotas and current utilization. We get the
-        // latter by issuing db.serverStatus() (mem.mapped) to all shards.
+        // latter by issuing db.serverStatus() (mem.mapped) to all shards.  The op counters and
+        // lock time are compared with the previous round's to get each shard's load.
         //
         // TODO: skip unresponsive shards and mark information as stale.
         //
@@ -246,6 +249,17 @@ namespace mongo {
                                                   s.tags(),
                                                   status.mongoVersion()
                                                   );
+
+            map<string,ShardStatus>::iterator last = _lastShardStatus.find( s.getName() );
+            if ( last != _lastShardStatus.end() ) {
+                const long long numChunks =
+                    conn.count( ChunkType::ConfigNS, BSON( ChunkType::shard( s.getName() ) ) );
+                shardInfo[ s.getName() ].setLoad( status.opsPerSecSince( last->second ),
+                                                  status.writeLockRatioSince( last->second ),
+                                                  numChunks );
+                _lastShardStatus.erase( last );
+            }
+            _lastShardStatus.insert( make_pair( s.getName(), status ) );
         }
 
         OCCASIONALLY warnOnMultiVersion( shardInfo );
@@ -253,6 +267,12 @@ namespace mongo {
         //
         // 3. For each collection, check if the balancing policy recommends moving anything around.
         //
+        // The loads are shard wide and were measured before any of this round's moves, so only
+        // one move to even them out is made per round.  Otherwise every collection could move a
+        // chunk from the same hot shard to the same cold one, and the receiver would overshoot.
+        //
+
+        bool loadMoveChosen = false;
 
         for (vector<string>::const_iterator it = collections.begin(); it != collections.end(); ++it ) {
             const string& ns = *it;
@@ -356,8 +376,13 @@ namespace mongo {
                 continue;
             }
 
-            CandidateChunk* p = _policy->balance( ns, status, _balancedLastTime );
-            if ( p ) candidateChunks->push_back( CandidateChunkPtr( p ) );
+            CandidateChunk* p = _policy->balance( ns, status, _balancedLastTime,
+                                                  considerLoad && ! loadMoveChosen );
+            if ( p ) {
+                if ( p->forLoad )
+                    loadMoveChosen = true;
+                candidateChunks->push_back( CandidateChunkPtr( p ) );
+            }
         }
     }
 
@@ -480,11 +505,14 @@ namespace mongo {
                         secondaryThrottle = balancerConfig[SettingsType::secondaryThrottle()].trueValue();
                     }
 
+                    bool balanceByLoad = balancerConfig["_balanceByLoad"].trueValue();
+
                     LOG(1) << "waitForDelete: " << waitForDelete << endl;
                     LOG(1) << "secondaryThrottle: " << secondaryThrottle << endl;
+                    LOG(1) << "balanceByLoad: " << balanceByLoad << endl;
 
                     vector<CandidateChunkPtr> candidateChunks;
-                    _doBalanceRound( conn.conn() , &candidateChunks );
+                    _doBalanceRound( conn.conn() , &candidateChunks, balanceByLoad );
                     if ( candidateChunks.size() == 0 ) {
                         LOG(1) << "no need to move any chunk" << endl;
                         _balancedLastTime = 0;
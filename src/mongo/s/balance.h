@@ -22,6 +22,7 @@
 
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/s/balancer_policy.h"
+#include "mongo/s/shard.h"
 #include "mongo/util/background.h"
 
 namespace mongo {
@@ -61,6 +62,9 @@ namespace mongo {
 
         // decide which chunks to move; owned here.
         scoped_ptr<BalancerPolicy> _policy;
+
+        // each shard's status at the previous round, the load is measured against it
+        map<string,ShardStatus> _lastShardStatus;
         
         /**
          * Checks that the balancer can connect to all servers it needs to do its job.
@@ -77,8 +81,11 @@ namespace mongo {
          *
          * @param conn is the connection with the config server(s)
          * @param candidateChunks (IN/OUT) filled with candidate chunks, one per collection, that could possibly be moved
+         * @param considerLoad also move chunks to even out the shards' operation rates
          */
-        void _doBalanceRound( DBClientBase& conn, vector<CandidateChunkPtr>* candidateChunks );
+        void _doBalanceRound( DBClientBase& conn,
+                              vector<CandidateChunkPtr>* candidateChunks,
+                              bool considerLoad );
 
         /**
          * Issues chunk migration request, one at a time.
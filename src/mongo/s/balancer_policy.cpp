@@ -73,30 +73,39 @@ namespace mongo {
         return total;
     }
 
+    bool DistributionStatus::_canReceive( const string& shard,
+                                          const ShardInfo& info,
+                                          const string& tag ) const {
+        if ( info.isSizeMaxed() ) {
+            LOG(1) << shard << " has already reached the maximum total chunk size." << endl;
+            return false;
+        }
+
+        if ( info.isDraining() ) {
+            LOG(1) << shard << " is currently draining." << endl;
+            return false;
+        }
+
+        if ( info.hasOpsQueued() ) {
+            LOG(1) << shard << " has writebacks queued." << endl;
+            return false;
+        }
+
+        if ( ! info.hasTag( tag ) ) {
+            LOG(1) << shard << " doesn't have right tag" << endl;
+            return false;
+        }
+
+        return true;
+    }
+
     string DistributionStatus::getBestReceieverShard( const string& tag ) const {
         string best;
         unsigned minChunks = numeric_limits<unsigned>::max();
 
         for ( ShardInfoMap::const_iterator i = _shardInfo.begin(); i != _shardInfo.end(); ++i ) {
-            if ( i->second.isSizeMaxed() ) {
-                LOG(1) << i->first << " has already reached the maximum total chunk size." << endl;
-                continue;
-            }
-
-            if ( i->second.isDraining() ) {
-                LOG(1) << i->first << " is currently draining." << endl;
-                continue;
-            }
-
-            if ( i->second.hasOpsQueued() ) {
-                LOG(1) << i->first << " has writebacks queued." << endl;
-                continue;
-            }
-
-            if ( ! i->second.hasTag( tag ) ) {
-                LOG(1) << i->first << " doesn't have right tag" << endl;
+            if ( ! _canReceive( i->first, i->second, tag ) )
                 continue;
-            }
 
             unsigned myChunks = numberOfChunksInShard( i->first );
             if ( myChunks >= minChunks ) {
@@ -133,6 +142,45 @@ namespace mongo {
         return worst;
     }
 
+    string DistributionStatus::getMostLoadedShard( const string& tag ) const {
+        string worst;
+        double maxOps = -1;
+
+        for ( ShardInfoMap::const_iterator i = _shardInfo.begin(); i != _shardInfo.end(); ++i ) {
+            if ( ! i->second.hasLoad() || i->second.hasOpsQueued() )
+                continue;
+
+            if ( numberOfChunksInShardWithTag( i->first, tag ) == 0 )
+                continue;
+
+            if ( i->second.getOpsPerSec() <= maxOps )
+                continue;
+
+            worst = i->first;
+            maxOps = i->second.getOpsPerSec();
+        }
+
+        return worst;
+    }
+
+    string DistributionStatus::getLeastLoadedReceiverShard( const string& tag ) const {
+        string best;
+        double minOps = numeric_limits<double>::max();
+
+        for ( ShardInfoMap::const_iterator i = _shardInfo.begin(); i != _shardInfo.end(); ++i ) {
+            if ( ! i->second.hasLoad() || ! _canReceive( i->first, i->second, tag ) )
+                continue;
+
+            if ( i->second.getOpsPerSec() >= minOps )
+                continue;
+
+            best = i->first;
+            minOps = i->second.getOpsPerSec();
+        }
+
+        return best;
+    }
+
     const vector<BSONObj>& DistributionStatus::getChunks( const string& shard ) const {
         ShardToChunksMap::const_iterator i = _shardChunks.find(shard);
         verify( i != _shardChunks.end() );
@@ -219,15 +267,85 @@ namespace mongo {
         }
         return false;
     }
+
+    MigrateInfo* BalancerPolicy::_balanceLoad( const string& ns,
+                                               const DistributionStatus& distribution,
+                                               const string& tag,
+                                               int threshold ) {
+        string from = distribution.getMostLoadedShard( tag );
+        if ( from.size() == 0 )
+            return NULL;
+
+        string to = distribution.getLeastLoadedReceiverShard( tag );
+        if ( to.size() == 0 || to == from )
+            return NULL;
+
+        const ShardInfo& fromInfo = distribution.shardInfo( from );
+        const ShardInfo& toInfo = distribution.shardInfo( to );
+
+        // Moving a shard's only chunk just moves its load somewhere else
+        const int fromChunks = distribution.numberOfChunksInShardWithTag( from, tag );
+        if ( fromChunks < 2 )
+            return NULL;
+
+        // There are no per chunk access counts, so each chunk of any collection is taken to carry
+        // an even share of its shard's operations.  Moving one is only worth it if it narrows the
+        // gap without turning the receiver into the hotter shard, otherwise the next round moves
+        // it back.
+        const double chunkOps = fromInfo.getOpsPerSecPerChunk();
+        const double gap = fromInfo.getOpsPerSec() - toInfo.getOpsPerSec();
+
+        LOG(1) << "collection : " << ns << endl;
+        LOG(1) << "hottest    : " << from << " ops/sec " << fromInfo.getOpsPerSec() << endl;
+        LOG(1) << "coolest    : " << to << " ops/sec " << toInfo.getOpsPerSec() << endl;
+        LOG(1) << "chunk ops  : " << chunkOps << endl;
+
+        if ( gap < 2 * chunkOps )
+            return NULL;
+
+        if ( toInfo.getWriteLockRatio() > fromInfo.getWriteLockRatio() ) {
+            LOG(1) << to << " has more write lock contention than " << from << endl;
+            return NULL;
+        }
+
+        // The chunk count pass must not want to undo this move
+        const int toChunks = distribution.numberOfChunksInShardWithTag( to, tag ) + 1;
+        if ( toChunks - ( fromChunks - 1 ) >= threshold )
+            return NULL;
+
+        string fewest = distribution.getBestReceieverShard( tag );
+        if ( fewest.size() &&
+             toChunks - (int)distribution.numberOfChunksInShardWithTag( fewest, tag ) >= threshold )
+            return NULL;
+
+        const vector<BSONObj>& chunks = distribution.getChunks( from );
+        for ( unsigned j = 0; j < chunks.size(); j++ ) {
+            if ( distribution.getTagForChunk( chunks[j] ) != tag )
+                continue;
+
+            if ( _isJumbo( chunks[j] ) )
+                continue;
+
+            log() << " ns: " << ns << " going to move " << chunks[j]
+                  << " from: " << from << " to: " << to << " tag [" << tag << "]"
+                  << " to even out load" << endl;
+            return new MigrateInfo( ns, to, from, chunks[j], true );
+        }
+
+        return NULL;
+    }
+
     MigrateInfo* BalancerPolicy::balance( const string& ns,
                                           const DistributionStatus& distribution,
-                                          int balancedLastTime ) {
+                                          int balancedLastTime,
+                                          bool considerLoad ) {
 
 
         // 1) check for shards that policy require to us to move off of:
         //    draining only
         // 2) check tag policy violations
         // 3) then we make sure chunks are balanced for each tag
+        // 4) if asked to, move chunks off the busiest shards while counts stay balanced
 
         // ----
 
@@ -329,6 +447,23 @@ namespace mongo {
         else if ( distribution.totalChunks() < 80 )
             threshold = 4;
 
+        // Evening out load means giving the hot shards fewer chunks.  Counts may then differ by up
+        // to half a shard's even share, and the count pass has to tolerate that or it would undo
+        // the load moves.  Until some shard has a load measurement there are no load moves to
+        // protect.
+        bool haveLoad = false;
+        for ( set<string>::const_iterator i = distribution.shards().begin();
+              i != distribution.shards().end(); ++i ) {
+            if ( distribution.shardInfo( *i ).hasLoad() )
+                haveLoad = true;
+        }
+
+        if ( considerLoad && haveLoad ) {
+            const int loadThreshold =
+                distribution.totalChunks() / distribution.shards().size() / 2;
+            threshold = std::max( threshold, loadThreshold );
+        }
+
         // randomize the order in which we balance the tags
         // this is so that one bad tag doesn't prevent others from getting balanced
         vector<string> tags;
@@ -398,6 +533,15 @@ namespace mongo {
             verify( false ); // should be impossible
         }
 
+        // 4) load
+        if ( considerLoad ) {
+            for ( unsigned i=0; i<tags.size(); i++ ) {
+                MigrateInfo* m = _balanceLoad( ns, distribution, tags[i], threshold );
+                if ( m )
+                    return m;
+            }
+        }
+
         // Everything is balanced here!
         return NULL;
     }
@@ -412,20 +556,39 @@ namespace mongo {
           _draining( draining ),
           _hasOpsQueued( opsQueued ),
           _tags( tags ),
-          _mongoVersion( mongoVersion ) {
+          _mongoVersion( mongoVersion ),
+          _hasLoad( false ),
+          _opsPerSec( 0 ),
+          _writeLockRatio( 0 ),
+          _numChunks( 0 ) {
     }
 
     ShardInfo::ShardInfo()
         : _maxSize( 0 ),
           _currSize( 0 ),
           _draining( false ),
-          _hasOpsQueued( false ) {
+          _hasOpsQueued( false ),
+          _hasLoad( false ),
+          _opsPerSec( 0 ),
+          _writeLockRatio( 0 ),
+          _numChunks( 0 ) {
     }
 
     void ShardInfo::addTag( const string& tag ) {
         _tags.insert( tag );
     }
 
+    void ShardInfo::setLoad( double opsPerSec, double writeLockRatio, long long numChunks ) {
+        _hasLoad = true;
+        _opsPerSec = opsPerSec;
+        _writeLockRatio = writeLockRatio;
+        _numChunks = numChunks;
+    }
+
+    double ShardInfo::getOpsPerSecPerChunk() const {
+        return _opsPerSec / std::max( 1LL, _numChunks );
+    }
+
 
     bool ShardInfo::isSizeMaxed() const {
         if ( _maxSize == 0 || _currSize == 0 )
@@ -452,6 +615,11 @@ namespace mongo {
                 ss << *i << ",";
         }
         ss << " version: " << _mongoVersion;
+        if ( _hasLoad ) {
+            ss << " opsPerSec: " << _opsPerSec;
+            ss << " writeLockRatio: " << _writeLockRatio;
+            ss << " numChunks: " << _numChunks;
+        }
         return ss.str();
     }
 
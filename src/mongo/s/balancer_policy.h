@@ -89,6 +89,24 @@ namespace mongo {
 
         string getMongoVersion() const { return _mongoVersion; }
 
+        /**
+         * Records the load measured on the shard since the previous balancing round: operations
+         * per second and the fraction of the time its global write lock was held.  'numChunks'
+         * is the number of chunks of every collection on the shard, which that load is spread
+         * over.
+         */
+        void setLoad( double opsPerSec, double writeLockRatio, long long numChunks );
+
+        /** @return true if a load measurement was recorded with setLoad() */
+        bool hasLoad() const { return _hasLoad; }
+
+        double getOpsPerSec() const { return _opsPerSec; }
+
+        double getWriteLockRatio() const { return _writeLockRatio; }
+
+        /** @return the operations per second of an average chunk of the shard */
+        double getOpsPerSecPerChunk() const;
+
         string toString() const;
         
     private:
@@ -98,6 +116,10 @@ namespace mongo {
         bool _hasOpsQueued;
         set<string> _tags;
         string _mongoVersion;
+        bool _hasLoad;
+        double _opsPerSec;
+        double _writeLockRatio;
+        long long _numChunks;
     };
     
     struct MigrateInfo {
@@ -105,9 +127,11 @@ namespace mongo {
         const string to;
         const string from;
         const ChunkInfo chunk;
+        const bool forLoad; // chosen to even out load rather than chunk counts
 
-        MigrateInfo( const string& a_ns , const string& a_to , const string& a_from , const BSONObj& a_chunk )
-            : ns( a_ns ) , to( a_to ) , from( a_from ), chunk( a_chunk ) {}
+        MigrateInfo( const string& a_ns , const string& a_to , const string& a_from , const BSONObj& a_chunk ,
+                     bool a_forLoad = false )
+            : ns( a_ns ) , to( a_to ) , from( a_from ), chunk( a_chunk ), forLoad( a_forLoad ) {}
 
 
     };
@@ -141,6 +165,18 @@ namespace mongo {
          */
         string getMostOverloadedShard( const string& forTag ) const;
 
+        /**
+         * @return the shard with the highest operation rate among those with chunks for the
+         *         given tag, or "" if none of them has a load measurement
+         */
+        string getMostLoadedShard( const string& forTag ) const;
+
+        /**
+         * @return the shard with the lowest operation rate among those able to receive a chunk
+         *         for the given tag, or "" if none of them has a load measurement
+         */
+        string getLeastLoadedReceiverShard( const string& forTag ) const;
+
 
         // ---- basic accessors, counters, etc...
 
@@ -172,6 +208,9 @@ namespace mongo {
         void dump() const;
         
     private:
+        /** @return true if 'shard' may be given a chunk with the given tag */
+        bool _canReceive( const string& shard, const ShardInfo& info, const string& tag ) const;
+
         const ShardInfoMap& _shardInfo;
         const ShardToChunksMap& _shardChunks;
         map<BSONObj,TagRange> _tagRanges;
@@ -190,15 +229,30 @@ namespace mongo {
          * @param ns is the collections namepace.
          * @param DistributionStatus holds all the info about the current state of the cluster/namespace
          * @param balancedLastTime is the number of chunks effectively moved in the last round.
+         * @param considerLoad once the chunk counts are balanced, also move chunks from the
+         *        shards with the highest operation rates, using the loads set on the ShardInfos.
+         *        The loads are shard wide, so a caller balancing several collections should
+         *        only take one move with forLoad set per round.
          * @returns NULL or MigrateInfo of the best move to make towards balacing the collection.
          *          caller owns the MigrateInfo instance
          */
         static MigrateInfo* balance( const string& ns,
                                      const DistributionStatus& distribution,
-                                     int balancedLastTime );
+                                     int balancedLastTime,
+                                     bool considerLoad = false );
 
     private:
         static bool _isJumbo( const BSONObj& chunk );
+
+        /**
+         * @return NULL or a move of a chunk with 'tag' from the most to the least loaded shard,
+         *         if it narrows the load gap without letting the chunk counts drift by
+         *         'threshold' or more
+         */
+        static MigrateInfo* _balanceLoad( const string& ns,
+                                          const DistributionStatus& distribution,
+                                          const string& tag,
+                                          int threshold );
     };
 
 
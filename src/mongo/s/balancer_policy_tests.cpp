@@ -519,5 +519,203 @@ namespace mongo {
                 }
             }
         }
+
+        TEST( BalancerPolicyTests, BalanceLoadTest ) {
+            ShardToChunksMap chunks;
+            addShard( chunks, 10, false );
+            addShard( chunks, 10, true );
+
+            ShardInfoMap shards;
+            shards["shard0"] = ShardInfo( 0, 10, false, false );
+            shards["shard1"] = ShardInfo( 0, 10, false, false );
+
+            // counts are even, so nothing moves without load information
+            {
+                DistributionStatus d( shards, chunks );
+                ASSERT( ! BalancerPolicy::balance( "ns", d, 0, true ) );
+            }
+
+            shards["shard0"].setLoad( 1000, 0.2, 10 );
+            shards["shard1"].setLoad( 100, 0.1, 10 );
+
+            DistributionStatus d( shards, chunks );
+            ASSERT( ! BalancerPolicy::balance( "ns", d, 0 ) );
+
+            scoped_ptr<MigrateInfo> m( BalancerPolicy::balance( "ns", d, 0, true ) );
+            ASSERT( m );
+            ASSERT_EQUALS( "shard0", m->from );
+            ASSERT_EQUALS( "shard1", m->to );
+        }
+
+        TEST( BalancerPolicyTests, BalanceLoadWriteLockTest ) {
+            ShardToChunksMap chunks;
+            addShard( chunks, 10, false );
+            addShard( chunks, 10, true );
+
+            // the receiver does fewer operations, but they hold the write lock for longer
+            ShardInfoMap shards;
+            shards["shard0"] = ShardInfo( 0, 10, false, false );
+            shards["shard0"].setLoad( 1000, 0.1, 10 );
+            shards["shard1"] = ShardInfo( 0, 10, false, false );
+            shards["shard1"].setLoad( 100, 0.5, 10 );
+
+            DistributionStatus d( shards, chunks );
+            ASSERT( ! BalancerPolicy::balance( "ns", d, 0, true ) );
+        }
+
+        TEST( BalancerPolicyTests, BalanceLoadSingleChunkTest ) {
+            ShardToChunksMap chunks;
+            addShard( chunks, 1, false );
+            addShard( chunks, 1, true );
+
+            // moving the only chunk would just move the hot spot
+            ShardInfoMap shards;
+            shards["shard0"] = ShardInfo( 0, 1, false, false );
+            shards["shard0"].setLoad( 1000, 0, 1 );
+            shards["shard1"] = ShardInfo( 0, 1, false, false );
+            shards["shard1"].setLoad( 0, 0, 1 );
+
+            DistributionStatus d( shards, chunks );
+            ASSERT( ! BalancerPolicy::balance( "ns", d, 0, true ) );
+        }
+
+        TEST( BalancerPolicyTests, BalanceLoadShardWideChunksTest ) {
+            ShardToChunksMap chunks;
+            addShard( chunks, 2, false );
+            addShard( chunks, 1, true );
+
+            // Half of shard0's operations would be one chunk of this collection, too much to
+            // move.  But the shard has 100 chunks of all collections, so one chunk is about 1%.
+            ShardInfoMap shards;
+            shards["shard0"] = ShardInfo( 0, 100, false, false );
+            shards["shard0"].setLoad( 1000, 0, 100 );
+            shards["shard1"] = ShardInfo( 0, 100, false, false );
+            shards["shard1"].setLoad( 100, 0, 100 );
+
+            DistributionStatus d( shards, chunks );
+            scoped_ptr<MigrateInfo> m( BalancerPolicy::balance( "ns", d, 0, true ) );
+            ASSERT( m );
+            ASSERT( m->forLoad );
+            ASSERT_EQUALS( "shard0", m->from );
+            ASSERT_EQUALS( "shard1", m->to );
+
+            // with only this collection's chunks on it, moving one would overshoot
+            shards["shard0"].setLoad( 1000, 0, 2 );
+            DistributionStatus d2( shards, chunks );
+            ASSERT( ! BalancerPolicy::balance( "ns", d2, 0, true ) );
+        }
+
+        TEST( BalancerPolicyTests, BalanceLoadThresholdTest ) {
+            ShardToChunksMap chunks;
+            addShard( chunks, 59, false );
+            addShard( chunks, 41, true );
+
+            ShardInfoMap shards;
+            shards["shard0"] = ShardInfo( 0, 59, false, false );
+            shards["shard1"] = ShardInfo( 0, 41, false, false );
+
+            // no shard has load data yet, so the usual count threshold of 8 applies
+            {
+                DistributionStatus d( shards, chunks );
+                scoped_ptr<MigrateInfo> m( BalancerPolicy::balance( "ns", d, 0, true ) );
+                ASSERT( m );
+                ASSERT( ! m->forLoad );
+                ASSERT_EQUALS( "shard0", m->from );
+            }
+
+            // with even loads, counts may differ by up to half a shard's share of the chunks
+            shards["shard0"].setLoad( 100, 0, 59 );
+            shards["shard1"].setLoad( 100, 0, 41 );
+            DistributionStatus d( shards, chunks );
+            ASSERT( ! BalancerPolicy::balance( "ns", d, 0, true ) );
+        }
+
+        /**
+         * Simulates balancing by load.  Every chunk of shard i serves chunkOps[i] operations per
+         * second, which the policy can't see: it only gets each shard's total.  Migrations are
+         * applied until the policy stops suggesting them.
+         *
+         * @return the operation rate of the busiest shard at the end, and fills 'maxImbalance'
+         *         with the largest difference in chunk counts left between two shards
+         */
+        double simulateLoadBalancing( const vector<double>& chunkOps,
+                                      unsigned chunksPerShard,
+                                      int* numMoves,
+                                      unsigned* maxImbalance ) {
+            ShardToChunksMap chunks;
+            map<BSONObj, double> opsByChunkMin;
+            for ( unsigned i = 0; i < chunkOps.size(); i++ ) {
+                addShard( chunks, chunksPerShard, i == chunkOps.size() - 1 );
+
+                const vector<BSONObj>& added = chunks[str::stream() << "shard" << i];
+                for ( unsigned j = 0; j < added.size(); j++ )
+                    opsByChunkMin[added[j][ChunkType::min()].Obj()] = chunkOps[i];
+            }
+
+            ShardInfoMap shards;
+            *numMoves = 0;
+            while ( true ) {
+                shards.clear();
+                for ( ShardToChunksMap::const_iterator i = chunks.begin(); i != chunks.end(); ++i ) {
+                    double ops = 0;
+                    for ( unsigned j = 0; j < i->second.size(); j++ )
+                        ops += opsByChunkMin[i->second[j][ChunkType::min()].Obj()];
+
+                    shards[i->first] = ShardInfo( 0, i->second.size(), false, false );
+                    shards[i->first].setLoad( ops, 0, i->second.size() );
+                }
+
+                DistributionStatus d( shards, chunks );
+                scoped_ptr<MigrateInfo> m(
+                        BalancerPolicy::balance( "ns", d, *numMoves != 0, true ) );
+                if ( ! m )
+                    break;
+
+                moveChunk( chunks, m.get() );
+
+                // a policy that doesn't settle would never stop moving chunks
+                ASSERT_LESS_THAN( ++*numMoves, 1000 );
+            }
+
+            double maxOps = 0;
+            unsigned minChunks = numeric_limits<unsigned>::max();
+            unsigned maxChunks = 0;
+            for ( ShardInfoMap::iterator it = shards.begin(); it != shards.end(); ++it ) {
+                log() << it->first << " : " << it->second.toString() << endl;
+                maxOps = std::max( maxOps, it->second.getOpsPerSec() );
+                minChunks = std::min( minChunks, (unsigned)it->second.getCurrSize() );
+                maxChunks = std::max( maxChunks, (unsigned)it->second.getCurrSize() );
+            }
+
+            *maxImbalance = maxChunks - minChunks;
+            return maxOps;
+        }
+
+        TEST( BalancerPolicyTests, LoadSimulation ) {
+            int numMoves;
+            unsigned maxImbalance;
+
+            // one very hot and one warm shard, 4 * 30 chunks
+            vector<double> chunkOps;
+            chunkOps.push_back( 10 );
+            chunkOps.push_back( 5 );
+            chunkOps.push_back( 1 );
+            chunkOps.push_back( 1 );
+
+            double maxOps = simulateLoadBalancing( chunkOps, 30, &numMoves, &maxImbalance );
+            log() << "load simulation: " << numMoves << " moves, busiest shard went from 300 to "
+                  << maxOps << " ops/sec" << endl;
+
+            ASSERT_GREATER_THAN( numMoves, 0 );
+            ASSERT_LESS_THAN( maxOps, 300 );
+            // counts may drift by half of a shard's share
+            ASSERT_LESS_THAN_OR_EQUALS( maxImbalance, 15U );
+
+            // an even load needs no moves
+            chunkOps.assign( 4, 1 );
+            maxOps = simulateLoadBalancing( chunkOps, 30, &numMoves, &maxImbalance );
+            ASSERT_EQUALS( 0, numMoves );
+            ASSERT_EQUALS( 30, maxOps );
+        }
     }
 }
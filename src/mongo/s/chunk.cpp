@@ -673,6 +673,7 @@ namespace mongo {
                     const_cast<set<Shard>&>(_shards).swap(shards);
                     const_cast<ShardVersionMap&>(_shardVersions).swap(shardVersions);
                     const_cast<ChunkRangeManager&>(_chunkRanges).reloadAll(_chunkMap);
+                    const_cast<ChunkRoutingTable&>(_routingTable).reloadAll(_chunkMap);
 
                     // Once we load data, clear reference to old manager
                     _oldManager.reset();
@@ -1048,10 +1049,10 @@ namespace mongo {
             BSONObj foo;
             ChunkPtr c;
             {
-                ChunkMap::const_iterator it = _chunkMap.upper_bound( point );
-                if (it != _chunkMap.end()) {
-                    foo = it->first;
-                    c = it->second;
+                size_t i = _routingTable.upperBound( point );
+                if (i != _routingTable.size()) {
+                    c = _routingTable.getChunk( i );
+                    foo = c->getMax();
                 }
             }
 
@@ -1381,6 +1382,44 @@ namespace mongo {
         }
     }
 
+    void ChunkRoutingTable::reloadAll(const ChunkMap& chunks) {
+        BSONArrayBuilder keys;
+        for (ChunkMap::const_iterator it = chunks.begin(), end = chunks.end(); it != end; ++it) {
+            keys.append(it->first);
+        }
+        _keyData = keys.obj();
+
+        _maxes.clear();
+        _chunks.clear();
+        _maxes.reserve(chunks.size());
+        _chunks.reserve(chunks.size());
+
+        BSONObjIterator keyIt(_keyData);
+        for (ChunkMap::const_iterator it = chunks.begin(), end = chunks.end(); it != end; ++it) {
+            // unowned views into _keyData, so copying them doesn't touch a refcount
+            _maxes.push_back(keyIt.next().embeddedObject());
+            _chunks.push_back(it->second);
+        }
+    }
+
+    size_t ChunkRoutingTable::upperBound(const BSONObj& point) const {
+        // same ordering as the ChunkMap's BSONObjCmp
+        size_t first = 0;
+        size_t count = _maxes.size();
+        while (count > 0) {
+            const size_t half = count / 2;
+            const size_t middle = first + half;
+            if (point.woCompare(_maxes[middle]) < 0) {
+                count = half;
+            }
+            else {
+                first = middle + 1;
+                count -= half + 1;
+            }
+        }
+        return first;
+    }
+
     int ChunkManager::getCurrentDesiredChunkSize() const {
         // split faster in early chunks helps spread out an initial load better
         const int minChunkSize = 1 << 20;  // 1 MBytes
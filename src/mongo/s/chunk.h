@@ -323,6 +323,30 @@ namespace mongo {
         ChunkRangeMap _ranges;
     };
 
+    /**
+     * The chunks ordered by their max key in sorted arrays, for finding the chunk that owns a key.
+     * The max keys are packed together into a single BSON buffer, so the binary search touches a
+     * few contiguous cache lines rather than a chain of map nodes and separately allocated keys.
+     * Like the rest of a ChunkManager it is built once during load and never changed after, so
+     * lookups take no locks.
+     */
+    class ChunkRoutingTable {
+    public:
+        void reloadAll(const ChunkMap& chunks);
+
+        size_t size() const { return _chunks.size(); }
+
+        /** Index of the first chunk whose max is greater than point, or size() if none */
+        size_t upperBound(const BSONObj& point) const;
+
+        const ChunkPtr& getChunk(size_t i) const { return _chunks[i]; }
+
+    private:
+        BSONObj _keyData;       // owns the bytes _maxes point into
+        vector<BSONObj> _maxes; // in shard key order, parallels _chunks
+        vector<ChunkPtr> _chunks;
+    };
+
     /* config.sharding
          { ns: 'alleyinsider.fs.chunks' ,
            key: { ts : 1 } ,
@@ -459,6 +483,7 @@ namespace mongo {
 
         const ChunkMap _chunkMap;
         const ChunkRangeManager _chunkRanges;
+        const ChunkRoutingTable _routingTable;
 
         const set<Shard> _shards;
 
@@ -100,6 +100,11 @@ namespace mongo {
         // Whether or not our RangeMap uses min or max keys
         virtual bool isMinKeyIndexed() const { return true; }
 
+        // Called for every valid diff once the ranges it overlaps have been removed, so that
+        // structures derived from the RangeMap can be updated for just the changed region.
+        // The min and max are not owned.
+        virtual void rangeChanged( const BSONObj& min, const BSONObj& max ) {}
+
         ///
         /// Start adapter functions
         /// TODO: Remove these when able
@@ -166,6 +166,8 @@ namespace mongo {
             // See if we need to remove any chunks we are currently tracking b/c of this chunk's changes
             removeOverlapping(diffChunkDoc[ChunkType::min()].Obj(),
                               diffChunkDoc[ChunkType::max()].Obj());
+            rangeChanged(diffChunkDoc[ChunkType::min()].Obj(),
+                         diffChunkDoc[ChunkType::max()].Obj());
 
             // Figure out which of the new chunks we need to track
             // Important - we need to actually own this doc, in case the cursor decides to getMore or unbuffer
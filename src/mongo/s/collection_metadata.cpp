@@ -87,10 +87,11 @@ namespace mongo {
         metadata->_pendingMap = this->_pendingMap;
         metadata->_chunksMap = this->_chunksMap;
         metadata->_chunksMap.erase( chunk.getMin() );
+        metadata->_rangesMap = this->_rangesMap;
         metadata->_shardVersion = newShardVersion;
         metadata->_collVersion =
                 newShardVersion > _collVersion ? newShardVersion : this->_collVersion;
-        metadata->fillRanges();
+        metadata->fillRanges( RangeVector( 1, make_pair( chunk.getMin(), chunk.getMax() ) ) );
 
         dassert(metadata->isValid());
         return metadata.release();
@@ -138,10 +139,11 @@ namespace mongo {
         metadata->_chunksMap = this->_chunksMap;
         metadata->_chunksMap.insert( make_pair( chunk.getMin().getOwned(),
                                                 chunk.getMax().getOwned() ) );
+        metadata->_rangesMap = this->_rangesMap;
         metadata->_shardVersion = newShardVersion;
         metadata->_collVersion =
                 newShardVersion > _collVersion ? newShardVersion : this->_collVersion;
-        metadata->fillRanges();
+        metadata->fillRanges( RangeVector( 1, make_pair( chunk.getMin(), chunk.getMax() ) ) );
 
         dassert(metadata->isValid());
         return metadata.release();
@@ -328,7 +330,9 @@ namespace mongo {
 
         metadata->_collVersion =
                 metadata->_shardVersion > _collVersion ? metadata->_shardVersion : _collVersion;
-        metadata->fillRanges();
+
+        // Splitting leaves the covered key space, and so the ranges, as they were
+        metadata->_rangesMap = this->_rangesMap;
 
         dassert(metadata->isValid());
         return metadata.release();
@@ -693,4 +697,45 @@ namespace mongo {
         _rangesMap.insert(make_pair(min, max));
     }
 
+    void CollectionMetadata::fillRanges( const RangeVector& changedRanges ) {
+        for ( RangeVector::const_iterator changedIt = changedRanges.begin();
+                changedIt != changedRanges.end(); ++changedIt ) {
+
+            BSONObj lo = changedIt->first;
+            BSONObj hi = changedIt->second;
+
+            // Drop the ranges overlapping or touching [lo, hi], they may need to be split or
+            // coalesced with their neighbors.  The span grows to cover whatever was dropped.
+            RangeMap::iterator it = _rangesMap.upper_bound( lo );
+            if ( it != _rangesMap.begin() ) {
+                RangeMap::iterator prev = it;
+                --prev;
+                if ( prev->second.woCompare( lo ) >= 0 ) it = prev;
+            }
+
+            while ( it != _rangesMap.end() && it->first.woCompare( hi ) <= 0 ) {
+                if ( it->first.woCompare( lo ) < 0 ) lo = it->first;
+                if ( it->second.woCompare( hi ) > 0 ) hi = it->second;
+                _rangesMap.erase( it++ );
+            }
+
+            // Coalesce the chunks now in the span back into ranges
+            RangeMap::const_iterator chunkIt = _chunksMap.lower_bound( lo );
+            BSONObj min, max;
+            while ( chunkIt != _chunksMap.end() && chunkIt->first.woCompare( hi ) < 0 ) {
+                if ( !min.isEmpty() && max.woCompare( chunkIt->first ) == 0 ) {
+                    max = chunkIt->second;
+                }
+                else {
+                    if ( !min.isEmpty() ) _rangesMap.insert( make_pair( min, max ) );
+                    min = chunkIt->first;
+                    max = chunkIt->second;
+                }
+                ++chunkIt;
+            }
+
+            if ( !min.isEmpty() ) _rangesMap.insert( make_pair( min, max ) );
+        }
+    }
+
 } // namespace mongo
@@ -283,6 +283,13 @@ namespace mongo {
          */
         void fillRanges();
 
+        /**
+         * Updates an existing _rangesMap after the chunks in 'changedRanges' were added to or
+         * removed from _chunksMap.  Only the ranges overlapping or adjacent to a changed span are
+         * rebuilt, so the cost follows the number of changes rather than the number of chunks.
+         */
+        void fillRanges( const RangeVector& changedRanges );
+
     };
 
 } // namespace mongo
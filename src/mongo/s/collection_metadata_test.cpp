@@ -1133,6 +1133,59 @@ namespace {
         ASSERT( getCollMetadata().getNextChunk(BSON("a" << 30), &nextChunk) );
     }
 
+    TEST_F(ThreeChunkWithRangeGapFixture, ClonePlusJoinsRanges) {
+
+        string errMsg;
+        ChunkType chunk;
+        chunk.setMin( BSON( "a" << 20 ) );
+        chunk.setMax( BSON( "a" << 30 ) );
+
+        ChunkVersion newShardVersion( 5, 0, getCollMetadata().getShardVersion().epoch() );
+        scoped_ptr<CollectionMetadata> cloned( getCollMetadata().clonePlusChunk( chunk,
+                                                                                 newShardVersion,
+                                                                                 &errMsg ) );
+
+        ASSERT_EQUALS( errMsg, "" );
+        ASSERT( cloned != NULL );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << MINKEY ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 15 ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 20 ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 25 ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 30 ) ) );
+        ASSERT_FALSE( cloned->keyBelongsToMe( BSON( "a" << MAXKEY ) ) );
+    }
+
+    TEST_F(ThreeChunkWithRangeGapFixture, CloneMinusSplitsRange) {
+
+        string errMsg;
+        ChunkType chunk;
+        chunk.setMin( BSON( "a" << 10 ) );
+        chunk.setMax( BSON( "a" << 20 ) );
+
+        ChunkVersion newShardVersion( 5, 0, getCollMetadata().getShardVersion().epoch() );
+        scoped_ptr<CollectionMetadata> cloned( getCollMetadata().cloneMinusChunk( chunk,
+                                                                                  newShardVersion,
+                                                                                  &errMsg ) );
+
+        ASSERT_EQUALS( errMsg, "" );
+        ASSERT( cloned != NULL );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 5 ) ) );
+        ASSERT_FALSE( cloned->keyBelongsToMe( BSON( "a" << 10 ) ) );
+        ASSERT_FALSE( cloned->keyBelongsToMe( BSON( "a" << 15 ) ) );
+        ASSERT_FALSE( cloned->keyBelongsToMe( BSON( "a" << 25 ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 40 ) ) );
+
+        // Adding the chunk back restores the original range
+        newShardVersion.incMajor();
+        cloned.reset( cloned->clonePlusChunk( chunk, newShardVersion, &errMsg ) );
+
+        ASSERT_EQUALS( errMsg, "" );
+        ASSERT( cloned != NULL );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 5 ) ) );
+        ASSERT( cloned->keyBelongsToMe( BSON( "a" << 15 ) ) );
+        ASSERT_FALSE( cloned->keyBelongsToMe( BSON( "a" << 25 ) ) );
+    }
+
     TEST_F(ThreeChunkWithRangeGapFixture, MergeChunkHoleInRange) {
 
         string errMsg;
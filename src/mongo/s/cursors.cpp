@@ -103,9 +103,13 @@ namespace mongo {
         uassert( 10191 ,  "cursor already done" , ! _done );
 
         int maxSize = 1024 * 1024;
-        if ( _totalSent > 0 )
+        if ( _totalSent > 0 ) {
             maxSize *= 3;
 
+            // the client is past its first batch, so the shards' next batches will be wanted
+            _cursor->prefetchBatches();
+        }
+
         docCount = 0;
 
         // Send more if ntoreturn is 0, or any value > 1
@@ -201,8 +205,13 @@ namespace mongo {
     }
     void CursorCache::remove( long long id ) {
         verify( id );
+        ShardedClientCursorPtr removed; // destroyed after the lock is released, see doTimeouts()
         scoped_lock lk( _mutex );
-        _cursors.erase( id );
+        MapSharded::iterator i = _cursors.find( id );
+        if ( i != _cursors.end() ) {
+            removed = i->second;
+            _cursors.erase( i );
+        }
     }
     
     void CursorCache::removeRef( long long id ) {
@@ -285,6 +294,10 @@ namespace mongo {
         uassert( 13287 , "too many cursors to kill" , n < 30000 );
 
         long long * cursors = (long long *)x;
+
+        // destroyed once done, outside _mutex, see doTimeouts()
+        vector<ShardedClientCursorPtr> killed;
+
         ClientBasic* client = ClientBasic::getCurrent();
         AuthorizationSession* authSession = client->getAuthorizationSession();
         for ( int i=0; i<n; i++ ) {
@@ -310,6 +323,7 @@ namespace mongo {
                             id,
                             isAuthorized ? ErrorCodes::OK : ErrorCodes::Unauthorized);
                     if (isAuthorized) {
+                        killed.push_back( i->second );
                         _cursors.erase( i );
                     }
                     continue;
@@ -356,6 +370,12 @@ namespace mongo {
 
     void CursorCache::doTimeouts() {
         long long now = Listener::getElapsedTimeMillis();
+
+        // A sharded cursor's destructor may have to read a prefetched batch off each of its
+        // shards before the connections can go back to the pool.  That must not happen under
+        // _mutex, where it would hold up every other cursor on this mongos.
+        vector<ShardedClientCursorPtr> expired;
+
         scoped_lock lk( _mutex );
         for ( MapSharded::iterator i=_cursors.begin(); i!=_cursors.end(); ++i ) {
             // Note: cursors with no timeout will always have an idleTime of 0
@@ -364,6 +384,7 @@ namespace mongo {
                 continue;
             }
             log() << "killing old cursor " << i->second->getId() << " idle for: " << idleFor << "ms" << endl; // TODO: make LOG(1)
+            expired.push_back( i->second );
             _cursors.erase( i );
             i = _cursors.begin(); // possible 2nd entry will get skipped, will get on next pass
             if ( i == _cursors.end() )
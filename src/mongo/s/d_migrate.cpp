@@ -33,6 +33,7 @@
 #include "mongo/client/connpool.h"
 #include "mongo/client/dbclientcursor.h"
 #include "mongo/client/distlock.h"
+#include "mongo/client/parallel.h"
 #include "mongo/db/auth/action_set.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_manager.h"
@@ -1613,28 +1614,51 @@ namespace mongo {
                 // 3. initial bulk clone
                 state = CLONE;
 
+                // The request for the next batch goes out before the current one is applied, so
+                // the donor gathers documents while we insert them.
+                shared_ptr<Future::CommandResult> nextBatch =
+                        Future::spawnCommand( from, "admin", BSON( "_migrateClone" << 1 ), 0,
+                                              conn.get() );
+
                 while ( true ) {
-                    BSONObj res;
-                    if ( ! conn->runCommand( "admin" , BSON( "_migrateClone" << 1 ) , res ) ) {  // gets array of objects to copy, in disk order
+                    if ( ! nextBatch->join() ) {  // gets array of objects to copy, in disk order
                         state = FAIL;
                         errmsg = "_migrateClone failed: ";
-                        errmsg += res.toString();
+                        errmsg += nextBatch->result().toString();
                         error() << errmsg << migrateLog;
                         conn.done();
                         return;
                     }
 
+                    // The documents point into this batch's reply, so it has to stay alive
+                    // until they are applied, after the next request has replaced nextBatch.
+                    shared_ptr<Future::CommandResult> batch = nextBatch;
+                    BSONObj res = batch->result();
                     BSONObj arr = res["objects"].Obj();
-                    int thisTime = 0;
+                    if ( arr.isEmpty() )
+                        break;
 
+                    nextBatch = Future::spawnCommand( from, "admin", BSON( "_migrateClone" << 1 ),
+                                                      0, conn.get() );
+
+                    vector<BSONObj> docs;
                     BSONObjIterator i( arr );
                     while( i.more() ) {
-                        BSONObj o = i.next().Obj();
-                        {
-                            PageFaultRetryableSection pgrs;
-                            while ( 1 ) {
-                                try {
-                                    Client::WriteContext cx( ns );
+                        docs.push_back( i.next().Obj() );
+                    }
+
+                    size_t numInserted = 0;
+                    while ( numInserted < docs.size() ) {
+                        // Insert as many documents as we can under one write lock, giving it up
+                        // as often as a yielding cursor would.
+                        ElapsedTracker yieldTracker( 128, 10 );
+                        PageFaultRetryableSection pgrs;
+                        while ( 1 ) {
+                            try {
+                                Client::WriteContext cx( ns );
+
+                                while ( numInserted < docs.size() ) {
+                                    const BSONObj& o = docs[numInserted];
 
                                     BSONObj localDoc;
                                     if ( willOverrideLocalId( o, &localDoc ) ) {
@@ -1651,26 +1675,28 @@ namespace mongo {
                                     }
 
                                     Helpers::upsert( ns, o, true );
-                                    break;
-                                }
-                                catch ( PageFaultException& e ) {
-                                    e.touch();
+
+                                    numInserted++;
+                                    numCloned++;
+                                    clonedBytes += o.objsize();
+
+                                    if ( yieldTracker.intervalHasElapsed() )
+                                        break;
                                 }
+                                break;
+                            }
+                            catch ( PageFaultException& e ) {
+                                e.touch();
                             }
                         }
-                        thisTime++;
-                        numCloned++;
-                        clonedBytes += o.objsize();
 
-                        if ( secondaryThrottle && thisTime > 0 ) {
+                        // Wait on the last insert made under the lock, which covers the others
+                        if ( secondaryThrottle ) {
                             if ( ! waitForReplication( cc().getLastOp(), 2, 60 /* seconds to wait */ ) ) {
                                 warning() << "secondaryThrottle on, but doc insert timed out after 60 seconds, continuing" << endl;
                             }
                         }
                     }
-
-                    if ( thisTime == 0 )
-                        break;
                 }
 
                 timing.done(3);
@@ -64,7 +64,14 @@ namespace mongo {
             return shard;
         }
 
+        virtual void rangeChanged( const BSONObj& min, const BSONObj& max ) {
+            _changedRanges.push_back( make_pair( min.getOwned(), max.getOwned() ) );
+        }
+
         string _currShard;
+
+        // Key ranges touched by the diffs, so the metadata ranges can be updated in place
+        RangeVector _changedRanges;
     };
 
     //
@@ -212,6 +219,7 @@ namespace mongo {
                 // TODO: This could be made more efficient if copying not required, but
                 // not as frequently reloaded as in mongos.
                 metadata->_chunksMap = oldMetadata->_chunksMap;
+                metadata->_rangesMap = oldMetadata->_rangesMap;
 
                 LOG( 2 ) << "loading new chunks for collection " << ns
                          << " using old metadata w/ version " << oldMetadata->getShardVersion()
@@ -242,6 +250,7 @@ namespace mongo {
                 // Make our metadata invalid
                 metadata->_collVersion = ChunkVersion( 0, 0, OID() );
                 metadata->_chunksMap.clear();
+                metadata->_rangesMap.clear();
                 conn.done();
 
                 return Status( ErrorCodes::HostUnreachable,
@@ -263,7 +272,17 @@ namespace mongo {
                            << " with version " << metadata->_collVersion << endl;
 
                 metadata->_shardVersion = versionMap[shard];
-                metadata->fillRanges();
+
+                // Only rebuild the ranges around the chunks which changed, unless most of
+                // them did
+                if ( fullReload
+                     || differ._changedRanges.size() > metadata->_chunksMap.size() / 2 ) {
+                    metadata->_rangesMap.clear();
+                    metadata->fillRanges();
+                }
+                else {
+                    metadata->fillRanges( differ._changedRanges );
+                }
                 conn.done();
 
                 dassert( metadata->isValid() );
@@ -286,6 +305,7 @@ namespace mongo {
 
                 metadata->_collVersion = ChunkVersion( 0, 0, OID() );
                 metadata->_chunksMap.clear();
+                metadata->_rangesMap.clear();
                 conn.done();
 
                 return fullReload ? Status( ErrorCodes::NamespaceNotFound, errMsg ) :
@@ -306,6 +326,7 @@ namespace mongo {
 
                 metadata->_collVersion = ChunkVersion( 0, 0, OID() );
                 metadata->_chunksMap.clear();
+                metadata->_rangesMap.clear();
                 conn.done();
 
                 return Status( ErrorCodes::RemoteChangeDetected, errMsg );
@@ -401,6 +401,32 @@ namespace mongo {
         _hasOpsQueued = obj["writeBacksQueued"].Bool();
         _writeLock = 0; // TODO
         _mongoVersion = obj["version"].String();
+
+        _opCount = 0;
+        BSONObjIterator i( obj.getObjectField( "opcounters" ) );
+        while ( i.more() ) {
+            BSONElement e = i.next();
+            if ( e.isNumber() )
+                _opCount += e.numberLong();
+        }
+
+        BSONObj globalLock = obj.getObjectField( "globalLock" );
+        _lockTime = globalLock["lockTime"].numberLong();
+        _lockTotalTime = globalLock["totalTime"].numberLong();
+    }
+
+    double ShardStatus::opsPerSecSince( const ShardStatus& earlier ) const {
+        long long elapsed = _lockTotalTime - earlier._lockTotalTime;
+        if ( elapsed <= 0 || _opCount < earlier._opCount )
+            return 0;
+        return ( _opCount - earlier._opCount ) * 1000000.0 / elapsed;
+    }
+
+    double ShardStatus::writeLockRatioSince( const ShardStatus& earlier ) const {
+        long long elapsed = _lockTotalTime - earlier._lockTotalTime;
+        if ( elapsed <= 0 || _lockTime < earlier._lockTime )
+            return 0;
+        return static_cast<double>( _lockTime - earlier._lockTime ) / elapsed;
     }
 
     void ShardingConnectionHook::onCreate( DBClientBase * conn ) {
@@ -210,12 +210,29 @@ namespace mongo {
             return _mongoVersion;
         }
 
+        /**
+         * @return operations per second between 'earlier' and this status of the same shard, or
+         * 0 if the shard restarted in between
+         */
+        double opsPerSecSince( const ShardStatus& earlier ) const;
+
+        /**
+         * @return fraction of the time between 'earlier' and this status that the shard held its
+         * global write lock, or 0 if the shard restarted in between
+         */
+        double writeLockRatioSince( const ShardStatus& earlier ) const;
+
     private:
         Shard _shard;
         long long _mapped;
         bool _hasOpsQueued;  // true if 'writebacks' are pending
         double _writeLock;
         string _mongoVersion;
+
+        // cumulative counters, only meaningful as a difference between two samples
+        long long _opCount;        // sum of the opcounters
+        long long _lockTime;       // micros the global write lock was held
+        long long _lockTotalTime;  // micros since the lock stats started
     };
 
     class ChunkManager;
@@ -507,6 +507,89 @@ namespace mongo {
             }
         }
 
+        /**
+         * Returns whether the next document of an insert goes to a shard we've written to since
+         * the last GLE, where inserting it would mask that shard's earlier error.  Answers true
+         * when the target can't be determined without preparing the next group.
+         */
+        bool _nextInsertRevisitsShard(const string& ns, DbMessage& d, ClientInfo* ci) {
+
+            ChunkManagerPtr manager = grid.getDBConfig(ns)->getChunkManagerIfExists(ns);
+            if (!manager) return true;
+
+            const char* nextObjMark = d.markGet();
+            BSONObj o = d.nextJsObj();
+            d.markReset(nextObjMark);
+
+            if (!manager->hasShardKey(o)) return true;
+
+            Shard shard = manager->findChunkForDoc(o)->getShard();
+            return ci->sinceLastGetError().count(shard.getConnString()) > 0;
+        }
+
+        /**
+         * Orders the documents of a continue-on-error insert into a sharded collection so each
+         * shard's documents are contiguous, keeping their relative order.  The insert loop then
+         * sends one group per shard instead of one per change of target shard, which for a batch
+         * over a hashed or random shard key is nearly one per document.  Since no shard is
+         * revisited, the loop sends every group without an intermediate GLE in between.
+         *
+         * Fills in 'grouped' and returns true if the documents were reordered, otherwise leaves
+         * 'd' at the start of the documents and returns false.
+         */
+        bool _groupInsertsByShard(const string& ns, DbMessage& d, int flags, Message* grouped) {
+
+            if (!(flags & InsertOption_ContinueOnError)) return false;
+
+            ChunkManagerPtr manager = grid.getDBConfig(ns)->getChunkManagerIfExists(ns);
+            if (!manager) return false;
+
+            d.markSet();
+
+            vector<string> shardOrder;
+            map<string, vector<BSONObj> > shardInserts;
+            bool contiguous = true;
+
+            while (d.moreJSObjs()) {
+                BSONObj o = d.nextJsObj();
+
+                // Leave documents needing a generated _id or without a shard key to the insert
+                // loop, which knows how to report them in order
+                if (!manager->hasShardKey(o)) {
+                    d.markReset();
+                    return false;
+                }
+
+                string shardName = manager->findChunkForDoc(o)->getShard().getName();
+
+                vector<BSONObj>& inserts = shardInserts[shardName];
+                if (inserts.empty()) shardOrder.push_back(shardName);
+                else if (shardOrder.back() != shardName) contiguous = false;
+
+                inserts.push_back(o);
+            }
+
+            d.markReset();
+            if (contiguous) return false;
+
+            BufBuilder b;
+            b.appendNum(d.reservedField());
+            b.appendStr(ns);
+            for (vector<string>::const_iterator it = shardOrder.begin(); it != shardOrder.end();
+                    ++it) {
+                const vector<BSONObj>& inserts = shardInserts[*it];
+                for (vector<BSONObj>::const_iterator i = inserts.begin(); i != inserts.end(); ++i)
+                    i->appendSelfToBufBuilder(b);
+            }
+
+            grouped->setData(dbInsert, b.buf(), b.len());
+
+            LOG(3) << "grouped continue-on-error insert to " << ns << " into "
+                   << shardOrder.size() << " shard groups" << endl;
+
+            return true;
+        }
+
         /**
          * This insert function now handes all inserts, unsharded or sharded, through mongos.
          *
@@ -527,6 +610,13 @@ namespace mongo {
 
             if (!d.moreJSObjs()) return;
 
+            Message grouped;
+            if (_groupInsertsByShard(ns, d, flags, &grouped)) {
+                DbMessage groupedD(grouped);
+                _insert(ns, groupedD, flags, r);
+                return;
+            }
+
             _insert(ns, d, flags, r);
         }
 
@@ -543,6 +633,9 @@ namespace mongo {
 
             bool prevInsertException = false;
 
+            // Whether shards written to since the last GLE still have to be checked
+            bool pendingGLE = false;
+
             while (d.moreJSObjs()) {
 
                 // TODO: Replace this with a better check to see if we're making progress
@@ -637,8 +730,22 @@ namespace mongo {
 
                             // We need to check the mongod error if we're inserting more documents,
                             // or if a later mongos error might mask an insert error,
-                            // or if an earlier error might mask this error from GLE
-                            if (d.moreJSObjs() || group.hasException() || prevInsertException) {
+                            // or if an earlier error might mask this error from GLE.
+                            //
+                            // A continue-on-error insert doesn't stop at the first error, so if
+                            // the next documents go to a shard we haven't written to since the
+                            // last GLE, nothing can mask this shard's error yet.  We leave the
+                            // shard pending and send the next group right away - the next GLE,
+                            // ours or the client's, gathers every pending shard at once.
+                            bool checkGLE = group.hasException() || prevInsertException;
+                            if (!checkGLE && d.moreJSObjs()) {
+                                checkGLE = !continueOnError ||
+                                           _nextInsertRevisitsShard(ns, d, r.getClientInfo());
+                            }
+
+                            pendingGLE = !checkGLE;
+
+                            if (checkGLE) {
 
                                 LOG(3) << "running intermediate GLE to "
                                        << group.shard->toString() << " during bulk insert "
@@ -791,8 +898,8 @@ namespace mongo {
                 }
 
                 // Reset our list of last shards we talked to, since we already got writebacks
-                // earlier.
-                if (d.moreJSObjs()) r.getClientInfo()->clearSinceLastGetError();
+                // earlier - unless their GLE is still pending.
+                if (d.moreJSObjs() && !pendingGLE) r.getClientInfo()->clearSinceLastGetError();
             }
         }
 
@@ -31,8 +31,10 @@ namespace mongo {
         _last( Listener::getElapsedTimeMillis() ) {
     }
 
-    bool ElapsedTracker::intervalHasElapsed() {
-        if ( ( ++_pings % _hitsBetweenMarks ) == 0 ) {
+    bool ElapsedTracker::intervalHasElapsed( int32_t hits ) {
+        const uint64_t before = _pings;
+        _pings += hits;
+        if ( before / _hitsBetweenMarks != _pings / _hitsBetweenMarks ) {
             _last = Listener::getElapsedTimeMillis();
             return true;
         }
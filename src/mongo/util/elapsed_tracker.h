@@ -29,9 +29,11 @@ namespace mongo {
 
         /**
          * Call this for every iteration.
+         * @param hits the number of iterations this call stands for, when a caller processes
+         *        several at a time.
          * @return true if one of the triggers has gone off.
          */
-        bool intervalHasElapsed();
+        bool intervalHasElapsed( int32_t hits = 1 );
 
         void resetLastTime();
         
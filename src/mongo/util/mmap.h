@@ -33,6 +33,9 @@ namespace mongo {
         ~MAdvise(); // destructor resets the range to MADV_NORMAL
     };
 
+    /** ask the os to start reading [p, p+len) in, without waiting for it.  a no-op where unsupported. */
+    void adviseWillNeed(const void *p, size_t len);
+
     // lock order: lock dbMutex before this if you lock both
     class LockMongoFilesShared { 
         friend class LockMongoFilesExclusive;
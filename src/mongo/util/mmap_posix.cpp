@@ -70,6 +70,7 @@ namespace mongo {
 #if defined(__sunos__)
     MAdvise::MAdvise(void *,unsigned, Advice) { }
     MAdvise::~MAdvise() { }
+    void adviseWillNeed(const void *, size_t) { }
 #else
     MAdvise::MAdvise(void *p, unsigned len, Advice a) {
         
@@ -92,6 +93,13 @@ namespace mongo {
     MAdvise::~MAdvise() { 
         madvise(_p,_len,MADV_NORMAL);
     }
+
+    void adviseWillNeed(const void *p, size_t len) {
+        void *start = (void*)((long)p & ~(g_minOSPageSizeBytes-1));
+        len += (unsigned long long)p - (unsigned long long)start;
+        // only a hint, if it fails the pages are read when they are touched
+        madvise(start, len, MADV_WILLNEED);
+    }
 #endif
 
     void* MemoryMappedFile::map(const char *filename, unsigned long long &length, int options) {